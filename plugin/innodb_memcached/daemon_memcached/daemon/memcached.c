@@ -581,6 +581,7 @@ static void conn_destructor(void *buffer, void *unused) {
     free(c->suffixlist);
     free(c->iov);
     free(c->msglist);
+    free(c->mget_buf);
 
     STATS_LOCK();
     stats.conn_structs--;
@@ -822,6 +823,12 @@ static void conn_shrink(conn *c) {
     /* TODO check error condition? */
     }
 
+    if (c->mget_size > MGET_BUFFER_HIGHWAT) {
+        free(c->mget_buf);
+        c->mget_buf = NULL;
+        c->mget_size = 0;
+    }
+
     if (c->iovsize > IOV_LIST_HIGHWAT) {
         struct iovec *newbuf = (struct iovec *) realloc((void *)c->iov, IOV_LIST_INITIAL * sizeof(c->iov[0]));
         if (newbuf) {
@@ -4053,6 +4060,266 @@ static char *get_suffix_buffer(conn *c) {
     return suffix;
 }
 
+/* A key of a multi-key get and where its response is in c->mget_buf */
+typedef struct {
+    token_t token;
+    size_t pos;   /* position of the key in the request */
+    size_t off;   /* offset of the response in c->mget_buf */
+    size_t len;   /* length of the response, 0 on a miss */
+} mget_key_t;
+
+/* Order the keys of a multi-key get by their bytes, for qsort() */
+static int mget_key_compare(const void *a, const void *b) {
+    const mget_key_t *ka = a;
+    const mget_key_t *kb = b;
+    size_t n = ka->token.length < kb->token.length
+        ? ka->token.length : kb->token.length;
+    int cmp = memcmp(ka->token.value, kb->token.value, n);
+
+    if (cmp != 0) {
+        return cmp;
+    }
+
+    if (ka->token.length != kb->token.length) {
+        return ka->token.length < kb->token.length ? -1 : 1;
+    }
+
+    return (ka->pos > kb->pos) - (ka->pos < kb->pos);
+}
+
+/* Order the keys of a multi-key get as in the request, for qsort() */
+static int mget_pos_compare(const void *a, const void *b) {
+    const mget_key_t *ka = a;
+    const mget_key_t *kb = b;
+
+    return (ka->pos > kb->pos) - (ka->pos < kb->pos);
+}
+
+/* Whether a key switches the table of the InnoDB engine, "@@table_id" or
+   "@@table_id.key". It applies to all the keys after it. */
+static bool mget_key_switches_table(const token_t *key) {
+    return key->length > 2 && key->value[0] == '@' && key->value[1] == '@';
+}
+
+/* Sort the runs of keys between table switches, so that the keys that
+   go to one table are looked up in index order */
+static void mget_sort_keys(mget_key_t *keys, size_t nkeys) {
+    size_t start = 0;
+    size_t i;
+
+    for (i = 0; i <= nkeys; i++) {
+        if (i == nkeys || mget_key_switches_table(&keys[i].token)) {
+            if (i - start > 1) {
+                qsort(keys + start, i - start, sizeof(*keys),
+                      mget_key_compare);
+            }
+
+            start = i + 1;
+        }
+    }
+}
+
+/* Make room for len more bytes in the multi-key get response buffer */
+static bool mget_buf_reserve(conn *c, size_t used, size_t len) {
+    if (used + len > c->mget_size) {
+        size_t size = c->mget_size ? c->mget_size : DATA_BUFFER_SIZE;
+        char *buf;
+
+        while (size < used + len) {
+            size *= 2;
+        }
+
+        buf = realloc(c->mget_buf, size);
+        if (buf == NULL) {
+            return false;
+        }
+
+        c->mget_buf = buf;
+        c->mget_size = size;
+    }
+
+    return true;
+}
+
+/*
+ * Serve a get with more than one key.
+ *
+ * The InnoDB engine returns items that point into a single result buffer
+ * per connection, which is overwritten by the next lookup. So each value
+ * is copied into c->mget_buf and its item is released before the next key
+ * is looked up. The keys between two "@@" table switches are looked up in
+ * sorted order, so that consecutive lookups go to the same or neighbouring
+ * index pages. The switches themselves stay in place, and the VALUE lines
+ * are sent in the order of the request.
+ */
+static char *process_mget_command(conn *c, token_t *tokens, bool return_cas) {
+    token_t *key_token = &tokens[KEY_TOKEN];
+    mget_key_t *keys = NULL;
+    size_t nkeys = 0;
+    size_t keys_size = 0;
+    size_t used = 0;
+    size_t i;
+
+    /* Collect the keys, the command line may take several passes of
+       tokenize_command() */
+    do {
+        while (key_token->length != 0) {
+            if (key_token->length > KEY_MAX_LENGTH) {
+                free(keys);
+                out_string(c, "CLIENT_ERROR bad command line format");
+                return NULL;
+            }
+
+            if (nkeys == keys_size) {
+                size_t size = keys_size ? keys_size * 2 : MAX_TOKENS;
+                mget_key_t *new_keys = realloc(keys, size * sizeof(*keys));
+
+                if (new_keys == NULL) {
+                    free(keys);
+                    out_string(c, "SERVER_ERROR out of memory");
+                    return NULL;
+                }
+
+                keys = new_keys;
+                keys_size = size;
+            }
+
+            keys[nkeys].token = *key_token;
+            keys[nkeys].pos = nkeys;
+            keys[nkeys].off = 0;
+            keys[nkeys].len = 0;
+            nkeys++;
+            key_token++;
+        }
+
+        if (key_token->value != NULL) {
+            tokenize_command(key_token->value, tokens, MAX_TOKENS);
+            key_token = tokens;
+        }
+    } while (key_token->value != NULL);
+
+    mget_sort_keys(keys, nkeys);
+
+    /* The engines shipped with this daemon never block in get, a multi-key
+       get does not resume after ENGINE_EWOULDBLOCK. */
+    c->aiostat = ENGINE_SUCCESS;
+
+    for (i = 0; i < nkeys; i++) {
+        char *key = keys[i].token.value;
+        size_t nkey = keys[i].token.length;
+        item *it = NULL;
+
+        if (settings.engine.v1->get(settings.engine.v0, c, &it, key, nkey, 0)
+            != ENGINE_SUCCESS) {
+            it = NULL;
+        }
+
+        if (settings.detail_enabled) {
+            stats_prefix_record_get(key, nkey, NULL != it);
+        }
+
+        if (it == NULL) {
+            STATS_MISS(c, get, key, nkey);
+            MEMCACHED_COMMAND_GET(c->sfd, key, nkey, -1, 0);
+            continue;
+        }
+
+        item_info info = { .nvalue = 1 };
+        if (!settings.engine.v1->get_item_info(settings.engine.v0, c, it,
+                                               &info)) {
+            settings.engine.v1->release(settings.engine.v0, c, it);
+            free(keys);
+            out_string(c, "SERVER_ERROR error getting item data");
+            return NULL;
+        }
+
+        /* "VALUE " key " " flags " " bytes [" " cas] "\r\n" data "\r\n" */
+        if (!mget_buf_reserve(c, used, 6 + info.nkey + 2 * SUFFIX_SIZE
+                              + info.value[0].iov_len + 2)) {
+            settings.engine.v1->release(settings.engine.v0, c, it);
+            free(keys);
+            out_string(c, "SERVER_ERROR out of memory writing get response");
+            return NULL;
+        }
+
+        MEMCACHED_COMMAND_GET(c->sfd, info.key, info.nkey,
+                              info.nbytes, info.cas);
+
+        keys[i].off = used;
+        memcpy(c->mget_buf + used, "VALUE ", 6);
+        used += 6;
+        memcpy(c->mget_buf + used, info.key, info.nkey);
+        used += info.nkey;
+        used += snprintf(c->mget_buf + used, SUFFIX_SIZE, " %u %u",
+                         htonl(info.flags), info.nbytes);
+        if (return_cas) {
+            used += snprintf(c->mget_buf + used, SUFFIX_SIZE,
+                             " %"PRIu64, info.cas);
+        }
+        memcpy(c->mget_buf + used, "\r\n", 2);
+        used += 2;
+        memcpy(c->mget_buf + used, info.value[0].iov_base,
+               info.value[0].iov_len);
+        used += info.value[0].iov_len;
+        memcpy(c->mget_buf + used, "\r\n", 2);
+        used += 2;
+        keys[i].len = used - keys[i].off;
+
+        settings.engine.v1->release(settings.engine.v0, c, it);
+
+        if (settings.verbose > 1) {
+            settings.extensions.logger->log(EXTENSION_LOG_DEBUG, c,
+                                            ">%d sending key %s\n",
+                                            c->sfd, key);
+        }
+
+        STATS_HIT(c, get, key, nkey);
+    }
+
+    /* Send the responses in the order of the request, merge the ones that
+       are already adjacent in c->mget_buf */
+    qsort(keys, nkeys, sizeof(*keys), mget_pos_compare);
+
+    for (i = 0; i < nkeys; i++) {
+        size_t off = keys[i].off;
+        size_t len = keys[i].len;
+
+        while (len > 0 && i + 1 < nkeys
+               && (keys[i + 1].len == 0
+                   || keys[i + 1].off == off + len)) {
+            len += keys[++i].len;
+        }
+
+        if (len > 0 && add_iov(c, c->mget_buf + off, len) != 0) {
+            free(keys);
+            out_string(c, "SERVER_ERROR out of memory writing get response");
+            return NULL;
+        }
+    }
+
+    free(keys);
+
+    c->icurr = c->ilist;
+    c->ileft = 0;
+    c->suffixcurr = c->suffixlist;
+
+    if (settings.verbose > 1) {
+        settings.extensions.logger->log(EXTENSION_LOG_DEBUG, c,
+                                        ">%d END\n", c->sfd);
+    }
+
+    if (add_iov(c, "END\r\n", 5) != 0
+        || (IS_UDP(c->transport) && build_udp_headers(c) != 0)) {
+        out_string(c, "SERVER_ERROR out of memory writing get response");
+    }
+    else {
+        conn_set_state(c, conn_mwrite);
+        c->msgcurr = 0;
+    }
+
+    return NULL;
+}
+
 /* ntokens is overwritten here... shrug.. */
 static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens, bool return_cas) {
     char *key;
@@ -4062,10 +4329,8 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
     token_t *key_token = &tokens[KEY_TOKEN];
     assert(c != NULL);
 
-    /* We temporarily block the mgets commands till wl6650 checked in. */
     if ((key_token + 1)->length > 0) {
-	out_string(c, "We temporarily don't support multiple get option.");
-	return NULL;
+        return process_mget_command(c, tokens, return_cas);
     }
 
     do {
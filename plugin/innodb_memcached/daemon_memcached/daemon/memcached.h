@@ -60,6 +60,7 @@
 #define ITEM_LIST_HIGHWAT 400
 #define IOV_LIST_HIGHWAT 600
 #define MSG_LIST_HIGHWAT 100
+#define MGET_BUFFER_HIGHWAT (64 * 1024)
 
 /* Binary protocol stuff */
 #define MIN_BIN_PKT_LENGTH 16
@@ -345,6 +346,9 @@ struct conn {
     char   **suffixcurr;
     int    suffixleft;
 
+    char   *mget_buf; /* responses of a multi-key get */
+    size_t mget_size;
+
     enum protocol protocol;   /* which protocol this connection speaks */
     enum network_transport transport; /* what transport is used by this connection */
 
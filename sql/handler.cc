@@ -6851,6 +6851,7 @@ int DsMrr_impl::dsmrr_fill_buffer()
   
   my_qsort2(rowids_buf, n_rowids, elem_size, (qsort2_cmp)rowid_cmp,
             (void*)h);
+  h->prefetch_rowids(rowids_buf, n_rowids, elem_size);
   rowids_buf_last= rowids_buf_cur;
   rowids_buf_cur=  rowids_buf;
   DBUG_RETURN(0);
@@ -3217,6 +3217,19 @@ public:
    return memcmp(ref1, ref2, ref_length);
  }
 
+ /**
+   Tell the engine that rnd_pos() is about to be called for a batch of
+   row ids, in the order given. The engine may start reading the pages
+   that hold the rows. The default implementation does nothing.
+
+   @param rowids     the first row id, ref_length bytes long
+   @param n_rowids   number of row ids
+   @param step       distance in bytes between two consecutive row ids
+ */
+ virtual void prefetch_rowids(const uchar *rowids, size_t n_rowids,
+                              uint step)
+ {}
+
  /*
    Condition pushdown to storage engines
  */
@@ -1965,6 +1965,138 @@ func_exit:
 	DBUG_VOID_RETURN;
 }
 
+/** This is a backported version of a lambda expression:
+  [&](buf_block_t *hint) {
+     return hint != nullptr && buf_page_optimistic_get(rw_latch, hint...);
+  }
+for compilers which do not support lambda expressions, nor passing local types
+as template arguments. */
+struct Btr_cur_leaf_hint_latch_functor_t {
+	ulint		rw_latch;
+	ib_uint64_t	modify_clock;
+	const char*	file;
+	ulint		line;
+	mtr_t*		mtr;
+	buf_block_t**	latched;
+	bool operator() (buf_block_t *hint) const {
+		if (hint == NULL || !buf_page_optimistic_get(
+			    rw_latch, hint, modify_clock,
+			    file, line, mtr)) {
+			return(false);
+		}
+		*latched = hint;
+		return(true);
+	}
+};
+
+/** Positions a tree cursor on the leaf page remembered in a hint, such as
+the page that received the previous insert of a multi-row batch, without
+descending the tree. The cursor is positioned with PAGE_CUR_LE only if
+the tuple is known to belong on the hinted page; otherwise nothing is
+latched and the caller must fall back to btr_cur_search_to_nth_level().
+@param[in,out]	hint		leaf page of the previous search
+@param[in]	index		clustered index
+@param[in]	tuple		search tuple
+@param[in]	latch_mode	BTR_MODIFY_LEAF or BTR_SEARCH_LEAF
+@param[out]	cursor		tree cursor; the leaf page is latched
+				on success
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return true if the cursor was positioned on the hinted page */
+bool
+btr_cur_search_leaf_with_hint(
+	btr_cur_leaf_hint_t*	hint,
+	dict_index_t*		index,
+	const dtuple_t*		tuple,
+	ulint			latch_mode,
+	btr_cur_t*		cursor,
+	const char*		file,
+	ulint			line,
+	mtr_t*			mtr)
+{
+	buf_block_t*	block = NULL;
+
+	ut_ad(dict_index_is_clust(index));
+	ut_ad(!dict_index_is_spatial(index));
+	ut_ad(!dict_table_is_intrinsic(index->table));
+	ut_ad(dtuple_check_typed(tuple));
+	ut_ad(latch_mode == BTR_MODIFY_LEAF || latch_mode == BTR_SEARCH_LEAF);
+
+	Btr_cur_leaf_hint_latch_functor_t	functor = {
+		latch_mode == BTR_SEARCH_LEAF ? RW_S_LATCH : RW_X_LATCH,
+		hint->modify_clock, file, line, mtr, &block};
+
+	if (!hint->block.run_with_hint(functor)) {
+		hint->block.clear();
+		return(false);
+	}
+
+	const page_t*	page = buf_block_get_frame(block);
+
+	/* The modify clock guarantees that the page was neither freed
+	nor reorganized, but the hint may come from another index that
+	shares the row_prebuilt_t, such as another partition. */
+	if (block->page.id.space() != dict_index_get_space(index)
+	    || btr_page_get_index_id(page) != index->id
+	    || !page_is_leaf(page)) {
+
+		btr_leaf_page_release(block, latch_mode, mtr);
+		hint->block.clear();
+		return(false);
+	}
+
+	buf_block_dbg_add_level(block, SYNC_TREE_NODE);
+
+	page_cur_t*	page_cursor = btr_cur_get_page_cur(cursor);
+	ulint		up_match = 0;
+	ulint		low_match = 0;
+
+	page_cur_search_with_match(
+		block, index, tuple, PAGE_CUR_LE, &up_match, &low_match,
+		page_cursor, NULL);
+
+	const rec_t*	rec = page_cur_get_rec(page_cursor);
+
+	/* Unless both neighbours of the insert position are user records
+	of this page, the tuple could belong to a sibling page. Only the
+	leftmost and rightmost leaf pages own the open-ended ranges. */
+	if ((page_rec_is_infimum(rec)
+	     && btr_page_get_prev(page, mtr) != FIL_NULL)
+	    || (page_rec_is_supremum(page_rec_get_next_const(rec))
+		&& btr_page_get_next(page, mtr) != FIL_NULL)) {
+
+		btr_leaf_page_release(block, latch_mode, mtr);
+		return(false);
+	}
+
+	cursor->flag = BTR_CUR_BINARY;
+	cursor->index = index;
+	cursor->low_match = low_match;
+	cursor->low_bytes = 0;
+	cursor->up_match = up_match;
+	cursor->up_bytes = 0;
+
+	return(true);
+}
+
+/** Remembers the leaf page a cursor was just positioned on, so that the
+next search of the same batch can try btr_cur_search_leaf_with_hint().
+@param[out]	hint	hint to update
+@param[in]	cursor	tree cursor on the latched leaf page */
+void
+btr_cur_leaf_hint_store(
+	btr_cur_leaf_hint_t*	hint,
+	const btr_cur_t*	cursor)
+{
+	buf_block_t*	block = btr_cur_get_block(cursor);
+
+	ut_ad(page_is_leaf(buf_block_get_frame(block)));
+
+	hint->block.store(block);
+	hint->modify_clock = buf_block_get_modify_clock(block);
+}
+
 /** Searches an index tree and positions a tree cursor on a given level.
 This function will avoid latching the traversal path and so should be
 used only for cases where-in latching is not needed.
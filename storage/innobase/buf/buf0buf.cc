@@ -5382,9 +5382,16 @@ buf_page_create(
 
 	rw_lock_x_unlock(hash_lock);
 
-	/* The block must be put to the LRU list */
+	/* The block must be put to the LRU list. Pages of temporary and
+	intrinsic tables start in the old sublist, like read-ahead pages,
+	so that a large sort or GROUP BY does not push the hot pages of
+	real tables out. They are made young by the usual
+	innodb_old_blocks_time rule, but only while the temporary
+	tablespace does not fill more than the share of the old
+	sublist; see buf_page_peek_if_too_old(). */
         // 将block添加到LRU链表
-	buf_LRU_add_block(&block->page, FALSE);
+	buf_LRU_add_block(&block->page,
+			  fsp_is_system_temporary(page_id.space()));
 
 	buf_block_buf_fix_inc(block, __FILE__, __LINE__);
 	buf_pool->stat.n_pages_created++;
@@ -5979,6 +5986,7 @@ buf_pool_invalidate_instance(
 	buf_pool->freed_page_clock = 0;
 	buf_pool->LRU_old = NULL;
 	buf_pool->LRU_old_len = 0;
+	buf_pool->LRU_temp_len = 0;
 
 	memset(&buf_pool->stat, 0x00, sizeof(buf_pool->stat));
 	buf_refresh_io_stats(buf_pool);
@@ -78,6 +78,10 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/** Number of consecutive dump entries that are sorted by (space, page)
+before being read during a load, see buf_load(). */
+static const ulint	BUF_LOAD_SORT_BATCH = 8192;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -263,29 +267,44 @@ Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_dump_status will be set accordingly, see buf_dump_status().
 The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+SET GLOBAL innodb_buffer_pool_filename='filename';
+The hottest pages of all buffer pool instances are written first: the LRU
+lists of the instances are interleaved, so that a load (or a load cut short
+because the buffer pool got smaller) warms up the hottest pages first. */
 static
 void
 buf_dump(
 /*=====*/
-	ibool	obey_shutdown)	/*!< in: quit if we are in a shutting down
+	ibool	obey_shutdown,	/*!< in: quit if we are in a shutting down
 				state */
+	bool	periodic)	/*!< in: true if this is a periodic dump
+				triggered by innodb_buffer_pool_dump_interval,
+				it is not reported in the error log */
 {
 #define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
 
-	char	full_filename[OS_FILE_MAX_PATH];
-	char	tmp_filename[OS_FILE_MAX_PATH + 11];
-	char	now[32];
-	FILE*	f;
-	ulint	i;
-	int	ret;
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		tmp_filename[OS_FILE_MAX_PATH + 11];
+	char		now[32];
+	FILE*		f;
+	ulint		i;
+	ulint		j;
+	int		ret;
+	buf_dump_t*	dumps[MAX_BUFFER_POOLS];
+	ulint		dumps_n[MAX_BUFFER_POOLS];
+	ulint		max_n = 0;
+	ulint		total_n = 0;
+	ulint		written = 0;
+
+	const status_severity	info_severity = periodic
+		? STATUS_VERBOSE : STATUS_INFO;
 
 	buf_dump_generate_path(full_filename, sizeof(full_filename));
 
 	ut_snprintf(tmp_filename, sizeof(tmp_filename),
 		    "%s.incomplete", full_filename);
 
-	buf_dump_status(STATUS_INFO, "Dumping buffer pool(s) to %s",
+	buf_dump_status(info_severity, "Dumping buffer pool(s) to %s",
 			full_filename);
 
 	f = fopen(tmp_filename, "w");
@@ -297,13 +316,16 @@ buf_dump(
 	}
 	/* else */
 
-	/* walk through each buffer pool */
+	memset(dumps, 0x0, sizeof(dumps));
+	memset(dumps_n, 0x0, sizeof(dumps_n));
+
+	/* walk through each buffer pool and copy the hottest part of its
+	LRU list */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
 		ulint			n_pages;
-		ulint			j;
 
 		buf_pool = buf_pool_from_array(i);
 
@@ -334,6 +356,9 @@ buf_dump(
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
+			for (j = 0; j < i; j++) {
+				ut_free(dumps[j]);
+			}
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
@@ -357,12 +382,28 @@ buf_dump(
 
 		buf_pool_mutex_exit(buf_pool);
 
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+		dumps[i] = dump;
+		dumps_n[i] = n_pages;
+		total_n += n_pages;
+		max_n = std::max(max_n, n_pages);
+	}
+
+	/* Write the LRU positions of all instances one after another, from
+	the most recently used to the least recently used. */
+	for (j = 0; j < max_n && !SHOULD_QUIT(); j++) {
+		for (i = 0; i < srv_buf_pool_instances; i++) {
+
+			if (j >= dumps_n[i]) {
+				continue;
+			}
+
 			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
+				      BUF_DUMP_SPACE(dumps[i][j]),
+				      BUF_DUMP_PAGE(dumps[i][j]));
 			if (ret < 0) {
-				ut_free(dump);
+				for (i = 0; i < srv_buf_pool_instances; i++) {
+					ut_free(dumps[i]);
+				}
 				fclose(f);
 				buf_dump_status(STATUS_ERR,
 						"Cannot write to '%s': %s",
@@ -371,18 +412,20 @@ buf_dump(
 				return;
 			}
 
-			if (j % 128 == 0) {
+			if (written % 128 == 0) {
 				buf_dump_status(
 					STATUS_VERBOSE,
-					"Dumping buffer pool"
-					" " ULINTPF "/" ULINTPF ","
+					"Dumping buffer pool(s),"
 					" page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
+					written + 1, total_n);
 			}
+
+			written++;
 		}
+	}
 
-		ut_free(dump);
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		ut_free(dumps[i]);
 	}
 
 	ret = fclose(f);
@@ -419,7 +462,7 @@ buf_dump(
 
 	ut_sprintf_timestamp(now);
 
-	buf_dump_status(STATUS_INFO,
+	buf_dump_status(info_severity,
 			"Buffer pool(s) dump completed at %s", now);
 }
 
@@ -638,16 +681,23 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+	/* The dump is ordered from the hottest to the coldest page. Sort
+it only in batches of BUF_LOAD_SORT_BATCH pages: the reads within a
+batch are issued in (space, page) order, while the hottest batches are
+still read first. */
+	for (i = 0; i < dump_n && !SHUTTING_DOWN();
+	     i += BUF_LOAD_SORT_BATCH) {
+		std::sort(dump + i,
+			  dump + std::min(i + BUF_LOAD_SORT_BATCH, dump_n));
 	}
 
 	ib_time_monotonic_ms_t		last_check_time = 0;
 	ulint		last_activity_cnt = 0;
 
 	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
+	page within the same tablespace. Each batch of dump[] is sorted by
+	(space, page), so the pages of a given tablespace are consecutive
+	within a batch. */
 	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
 	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
 	page_size_t	page_size(space ? space->flags : 0);
@@ -789,11 +839,23 @@ DECLARE_THREAD(buf_dump_thread)(
 
 	while (!SHUTTING_DOWN()) {
 
-		os_event_wait(srv_buf_dump_event);
+		const ulong	interval = srv_buf_dump_interval;
+
+		if (interval == 0) {
+			os_event_wait(srv_buf_dump_event);
+		} else if (os_event_wait_time(srv_buf_dump_event,
+					      interval * 1000000)
+			   == OS_SYNC_TIME_EXCEEDED
+			   && !SHUTTING_DOWN()) {
+			/* Dump in the background, so that a restart or
+			a failover finds a recent list of hot pages. */
+			buf_dump(TRUE /* quit on shutdown */, true);
+			continue;
+		}
 
 		if (buf_dump_should_start) {
 			buf_dump_should_start = FALSE;
-			buf_dump(TRUE /* quit on shutdown */);
+			buf_dump(TRUE /* quit on shutdown */, false);
 		}
 
 		if (buf_load_should_start) {
@@ -806,7 +868,7 @@ DECLARE_THREAD(buf_dump_thread)(
 
 	if (srv_buffer_pool_dump_at_shutdown && srv_fast_shutdown != 2) {
 		buf_dump(FALSE /* ignore shutdown down flag,
-		keep going even if we are in a shutdown state */);
+		keep going even if we are in a shutdown state */, false);
 	}
 
 	srv_buf_dump_thread_active = FALSE;
@@ -181,6 +181,10 @@ incr_LRU_size_in_bytes(
 	buf_pool->stat.LRU_bytes += bpage->size.physical();
 
 	ut_ad(buf_pool->stat.LRU_bytes <= buf_pool->curr_pool_size);
+
+	if (fsp_is_system_temporary(bpage->id.space())) {
+		buf_pool->LRU_temp_len++;
+	}
 }
 
 /******************************************************************//**
@@ -1632,6 +1636,11 @@ buf_LRU_remove_block(
 
 	buf_pool->stat.LRU_bytes -= bpage->size.physical();
 
+	if (fsp_is_system_temporary(bpage->id.space())) {
+		ut_ad(buf_pool->LRU_temp_len > 0);
+		buf_pool->LRU_temp_len--;
+	}
+
 	buf_unzip_LRU_remove_block_if_needed(bpage);
 
 	/* If the LRU list is so short that LRU_old is not defined,
@@ -1561,45 +1561,45 @@ dict_table_can_be_evicted(
 Make room in the table cache by evicting an unused table. The unused table
 should not be part of FK relationship and currently not used in any user
 transaction. There is no guarantee that it will remove a table.
+Tables that are checked but cannot be evicted are moved to the start of the
+LRU list, so that a caller that releases dict_sys->mutex between calls does
+not check them again.
 @return number of tables evicted. If the number of tables in the dict_LRU
 is less than max_tables it will not do anything. */
 ulint
 dict_make_room_in_cache(
 /*====================*/
 	ulint		max_tables,	/*!< in: max tables allowed in cache */
-	ulint		pct_check)	/*!< in: max percent to check */
+	ulint		n_check,	/*!< in: max number of tables to
+					check */
+	ulint*		n_checked)	/*!< out: number of tables checked */
 {
-	ulint		i;
 	ulint		len;
 	dict_table_t*	table;
-	ulint		check_up_to;
 	ulint		n_evicted = 0;
 
-	ut_a(pct_check > 0);
-	ut_a(pct_check <= 100);
 	ut_ad(mutex_own(&dict_sys->mutex));
 	ut_ad(rw_lock_own(dict_operation_lock, RW_LOCK_X));
 	ut_ad(dict_lru_validate());
 
-	i = len = UT_LIST_GET_LEN(dict_sys->table_LRU);
+	*n_checked = 0;
+
+	len = UT_LIST_GET_LEN(dict_sys->table_LRU);
 
 	if (len < max_tables) {
 		return(0);
 	}
 
-	check_up_to = len - ((len * pct_check) / 100);
-
-	/* Check for overflow */
-	ut_a(i == 0 || check_up_to <= i);
+	n_check = ut_min(n_check, len);
 
 	/* Find a suitable candidate to evict from the cache. Don't scan the
-	entire LRU list. Only scan pct_check list entries. */
+	entire LRU list. Only scan n_check list entries. */
 
 	for (table = UT_LIST_GET_LAST(dict_sys->table_LRU);
 	     table != NULL
-	     && i > check_up_to
+	     && *n_checked < n_check
 	     && (len - n_evicted) > max_tables;
-	     --i) {
+	     ++*n_checked) {
 
 		dict_table_t*	prev_table;
 
@@ -1617,6 +1617,8 @@ dict_make_room_in_cache(
 			dict_table_remove_from_cache_low(table, TRUE);
 
 			++n_evicted;
+		} else {
+			dict_move_to_mru(table);
 		}
 
 		table = prev_table;
@@ -6845,13 +6847,22 @@ dict_index_zip_pad_update(
 	if (fail_pct > zip_threshold) {
 		/* Compression failures are more then user defined
 		threshold. Increase the pad size to reduce chances of
-		compression failures. */
+		compression failures. Every failed compression costs a
+		decompression and usually a page split, so when the
+		failure rate is a multiple of the threshold, grow the
+		pad by as many steps at once instead of failing for
+		that many more rounds. */
 		ut_ad(info->pad % ZIP_PAD_INCR == 0);
 
+		ulint	n_incr = ut_min(
+			fail_pct / zip_threshold,
+			static_cast<ulint>(ZIP_PAD_MAX_INCR_STEPS));
+
 		/* Only do increment if it won't increase padding
 		beyond max pad size. */
-		if (info->pad + ZIP_PAD_INCR
-		    < (UNIV_PAGE_SIZE * zip_pad_max) / 100) {
+		while (n_incr-- > 0
+		       && info->pad + ZIP_PAD_INCR
+		       < (UNIV_PAGE_SIZE * zip_pad_max) / 100) {
 			/* Use atomics even though we have the mutex.
 			This is to ensure that we are able to read
 			info->pad atomically. */
@@ -1463,14 +1463,33 @@ dict_check_sys_tables(
 							 is_temp,
 							 is_encrypted);
 
-		dberr_t	err = fil_ibd_open(
-			validate,
-			!srv_read_only_mode && srv_log_file_size != 0,
-			FIL_TYPE_TABLESPACE,
-			space_id,
-			fsp_flags,
-			space_name,
-			filepath);
+		dberr_t	err;
+
+		/* Without recovery, a file-per-table tablespace in the
+		default location does not need to be looked at now; it
+		will be opened and validated when it is first accessed.
+		Remote, shared, encrypted and temporary tablespaces still
+		go through fil_ibd_open() so that ISL files are resolved
+		and the dictionary is fixed. */
+		if (!validate
+		    && !srv_validate_tablespace_paths
+		    && filepath != NULL
+		    && !DICT_TF_HAS_SHARED_SPACE(flags)
+		    && !DICT_TF_HAS_DATA_DIR(flags)
+		    && !is_temp && !is_encrypted) {
+
+			err = fil_ibd_open_deferred(
+				space_id, fsp_flags, space_name, filepath);
+		} else {
+			err = fil_ibd_open(
+				validate,
+				!srv_read_only_mode && srv_log_file_size != 0,
+				FIL_TYPE_TABLESPACE,
+				space_id,
+				fsp_flags,
+				space_name,
+				filepath);
+		}
 
 		if (err != DB_SUCCESS) {
 			ib::warn() << "Ignoring tablespace "
@@ -2971,6 +2990,17 @@ dict_load_tablespace(
 	if (fil_space_for_table_exists_in_mem(
 		    table->space, space_name, false,
 		    true, heap, table->id)) {
+
+		/* If the data file was not looked at during startup,
+		check it now, so that a missing or replaced file makes
+		the table unusable instead of failing its page reads. */
+		if (!fil_space_open_deferred(table->space)) {
+			ib::error() << "Cannot open the data file of table "
+				<< table->name << " with space id "
+				<< table->space << ".";
+			table->ibd_file_missing = TRUE;
+		}
+
 		ut_free(shared_space_name);
 		return;
 	}
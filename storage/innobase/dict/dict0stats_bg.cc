@@ -90,9 +90,13 @@ use 'srv_shutdown_state' because we want to shutdown dict stats thread
 before purge thread. */
 static bool dict_stats_start_shutdown;
 
-/** Event to wait for shutdown of the dict stats thread */
+/** Event to wait for shutdown of the dict stats threads */
 static os_event_t dict_stats_shutdown_event;
 
+/** Number of dict stats threads that have not exited yet, protected by
+recalc_pool_mutex */
+static ulint dict_stats_n_threads;
+
 /*****************************************************************//**
 Initialize the recalc pool, called once during thread initialization. */
 static
@@ -133,7 +137,10 @@ then it will be removed from the pool and skipped. */
 void
 dict_stats_recalc_pool_add(
 /*=======================*/
-	const dict_table_t*	table)	/*!< in: table to add */
+	const dict_table_t*	table,	/*!< in: table to add */
+	bool			schedule_wake)
+					/*!< in: whether to wake up the
+					stats threads */
 {
 	ut_ad(!srv_read_only_mode);
 
@@ -154,7 +161,9 @@ dict_stats_recalc_pool_add(
 
 	mutex_exit(&recalc_pool_mutex);
 
-	os_event_set(dict_stats_event);
+	if (schedule_wake) {
+		os_event_set(dict_stats_event);
+	}
 }
 
 /*****************************************************************//**
@@ -186,6 +195,21 @@ dict_stats_recalc_pool_get(
 	return(true);
 }
 
+/** Get the number of tables in the auto recalc pool.
+@return number of tables */
+static
+ulint
+dict_stats_recalc_pool_len()
+{
+	mutex_enter(&recalc_pool_mutex);
+
+	ulint	len = recalc_pool->size();
+
+	mutex_exit(&recalc_pool_mutex);
+
+	return(len);
+}
+
 /*****************************************************************//**
 Delete a given table from the auto recalc pool.
 dict_stats_recalc_pool_del() */
@@ -267,6 +291,8 @@ dict_stats_thread_init()
 	mutex_create(LATCH_ID_RECALC_POOL, &recalc_pool_mutex);
 
 	dict_stats_recalc_pool_init();
+
+	dict_stats_n_threads = srv_n_stats_threads;
 }
 
 /*****************************************************************//**
@@ -297,7 +323,8 @@ dict_stats_thread_deinit()
 
 /*****************************************************************//**
 Get the first table that has been added for auto recalc and eventually
-update its stats. */
+update its stats. Several stats threads may run this concurrently, each
+of them on a different table. */
 static
 void
 dict_stats_process_entry_from_recalc_pool()
@@ -339,10 +366,30 @@ dict_stats_process_entry_from_recalc_pool()
 		return;
 	}
 
-	table->stats_bg_flag = BG_STAT_IN_PROGRESS;
+	if (table->stats_bg_flag & BG_STAT_IN_PROGRESS) {
+		/* Another stats thread is working on this table. It
+		may have sampled the table before the changes that made
+		it be added again, so put it back for a later round. */
+		dict_stats_recalc_pool_add(table, false);
+		dict_table_close(table, TRUE, FALSE);
+		mutex_exit(&dict_sys->mutex);
+		return;
+	}
+
+	table->stats_bg_flag |= BG_STAT_IN_PROGRESS;
 
 	mutex_exit(&dict_sys->mutex);
 
+	/* Keep the first table that gets here marked as in progress
+	until the test removes dict_stats_bg_held. */
+	DBUG_EXECUTE_IF(
+		"dict_stats_bg_hold_in_progress",
+		DBUG_SET_INITIAL("-d,dict_stats_bg_hold_in_progress");
+		DBUG_SET_INITIAL("+d,dict_stats_bg_held");
+		while (DBUG_EVALUATE_IF("dict_stats_bg_held", true, false)) {
+			os_thread_sleep(10000);
+		});
+
 	/* ut_time_monotonic() could be expensive, the current function
 	is called once every time a table has been changed more than 10% and
 	on a system with lots of small tables, this could become hot. If we
@@ -350,22 +397,29 @@ dict_stats_process_entry_from_recalc_pool()
 	be replaced with something else, though a time interval is the natural
 	approach. */
 
-	if (ut_time_monotonic() - table->stats_last_recalc < MIN_RECALC_INTERVAL) {
-
-		/* Stats were (re)calculated not long ago. To avoid
-		too frequent stats updates we put back the table on
-		the auto recalc list and do nothing. */
-
-		dict_stats_recalc_pool_add(table);
-
-	} else {
+	const bool	requeue = ut_time_monotonic() - table->stats_last_recalc
+		< MIN_RECALC_INTERVAL;
 
+	if (!requeue) {
 		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
 	}
 
 	mutex_enter(&dict_sys->mutex);
 
-	table->stats_bg_flag = BG_STAT_NONE;
+	/* BG_STAT_SHOULD_QUIT was meant for this run only. */
+	table->stats_bg_flag &= ~(BG_STAT_IN_PROGRESS | BG_STAT_SHOULD_QUIT);
+
+	if (requeue) {
+		/* Stats were (re)calculated not long ago. To avoid
+		too frequent stats updates we put back the table on
+		the auto recalc list and do nothing. This is done only
+		after BG_STAT_IN_PROGRESS was cleared, so that another
+		stats thread that picks up the table does not have
+		its flag overwritten. The stats threads are not woken
+		up, the table will be looked at on the next round. */
+
+		dict_stats_recalc_pool_add(table, false);
+	}
 
 	dict_table_close(table, TRUE, FALSE);
 
@@ -405,7 +459,7 @@ dict_stats_disabled_debug_update(
 /*****************************************************************//**
 This is the thread for background stats gathering. It pops tables, from
 the auto recalc list and proceeds them, eventually recalculating their
-statistics.
+statistics. innodb_stats_threads of these threads share the list.
 @return this function does not return, it calls os_thread_exit() */
 extern "C"
 os_thread_ret_t
@@ -426,11 +480,10 @@ DECLARE_THREAD(dict_stats_thread)(
 
 	while (!dict_stats_start_shutdown) {
 
-		/* Wake up periodically even if not signaled. This is
-		because we may lose an event - if the below call to
-		dict_stats_process_entry_from_recalc_pool() puts the entry back
-		in the list, the os_event_set() will be lost by the subsequent
-		os_event_reset(). */
+		/* Wake up periodically even if not signaled, to look
+		again at the tables that were put back in the list by
+		dict_stats_process_entry_from_recalc_pool() without
+		signaling the event. */
 		os_event_wait_time(
 			dict_stats_event, MIN_RECALC_INTERVAL * 1000000);
 
@@ -449,14 +502,34 @@ DECLARE_THREAD(dict_stats_thread)(
 			break;
 		}
 
-		dict_stats_process_entry_from_recalc_pool();
-
+		/* Reset the event before draining the list, so that
+		tables added meanwhile are not missed. */
 		os_event_reset(dict_stats_event);
+
+		/* Go through the whole list instead of processing one
+		table per wake-up; many tables often cross the change
+		threshold at the same time. Tables that are put back in
+		the list are looked at again on the next round. */
+		for (ulint n = dict_stats_recalc_pool_len();
+		     n > 0 && !dict_stats_start_shutdown;
+		     --n) {
+
+			dict_stats_process_entry_from_recalc_pool();
+		}
+	}
+
+	mutex_enter(&recalc_pool_mutex);
+
+	ut_a(dict_stats_n_threads > 0);
+
+	if (--dict_stats_n_threads == 0) {
+		srv_dict_stats_thread_active = FALSE;
+
+		os_event_set(dict_stats_shutdown_event);
 	}
 
-	srv_dict_stats_thread_active = FALSE;
+	mutex_exit(&recalc_pool_mutex);
 
-	os_event_set(dict_stats_shutdown_event);
 	my_thread_end();
 
 	/* We count the number of threads in os_thread_exit(). A created
@@ -466,7 +539,7 @@ DECLARE_THREAD(dict_stats_thread)(
 	OS_THREAD_DUMMY_RETURN;
 }
 
-/** Shutdown the dict stats thread. */
+/** Shutdown the dict stats threads. */
 void
 dict_stats_shutdown()
 {
@@ -159,6 +159,10 @@ ulint	fil_n_file_opened			= 0;
 /** The null file address */
 fil_addr_t	fil_addr_null = {FIL_NULL, 0};
 
+/** The background closer keeps at least 1/FIL_LRU_CLOSE_MARGIN of
+innodb_open_files free, see fil_close_lru_files() */
+static const ulint	FIL_LRU_CLOSE_MARGIN = 16;
+
 /** The tablespace memory cache; also the totality of logs (the log
 data space) is stored here; below we talk about tablespaces, but also
 the ib_logfiles form a 'space' and it is handled here */
@@ -790,6 +794,24 @@ retry:
 
 		os_file_close(node->handle);
 
+		/* A file that was not looked at during startup may have
+		been removed or replaced meanwhile. Treat it like a
+		missing file, as fil_ibd_open() would have done. */
+		if (space->deferred
+		    && (!success
+			|| space_id != space->id
+			|| flags != space->flags)) {
+
+			ib::error() << "Tablespace id is " << space->id
+				<< " and flags are " << ib::hex(space->flags)
+				<< " in the data dictionary but in file "
+				<< node->name << " they are " << space_id
+				<< " and " << ib::hex(flags) << "!";
+
+			ut_free(buf2);
+			return(false);
+		}
+
 		const page_size_t	page_size(flags);
 
 		min_size = FIL_IBD_FILE_INITIAL_SIZE * page_size.physical();
@@ -800,6 +822,11 @@ retry:
 				<< node->name << " is only " << size_bytes
 				<< ", should be at least " << min_size << "!";
 
+			if (space->deferred) {
+				ut_free(buf2);
+				return(false);
+			}
+
 			ut_error;
 		}
 
@@ -875,6 +902,8 @@ retry:
 			}
 		}
 
+		space->deferred = false;
+
 		if (node->size == 0) {
 			uint64_t	extent_size;
 
@@ -1038,6 +1067,42 @@ fil_try_to_close_file_in_LRU(
 	return(false);
 }
 
+/** Close least recently used data files in the background until the
+number of open files drops below the low water mark of
+fil_system->max_n_open. Keeping some headroom means that a thread doing
+i/o on a closed file rarely has to close another file while holding
+fil_system->mutex in fil_mutex_enter_and_prepare_for_io(). The mutex is
+released between closing two files so that i/o is not stalled.
+@param[in]	n_max	maximum number of files to close
+@return number of files closed */
+ulint
+fil_close_lru_files(
+	ulint	n_max)
+{
+	ulint	n_closed = 0;
+
+	while (n_closed < n_max) {
+
+		mutex_enter(&fil_system->mutex);
+
+		ulint	low_water = fil_system->max_n_open
+			- fil_system->max_n_open / FIL_LRU_CLOSE_MARGIN;
+
+		bool	closed = fil_system->n_open > low_water
+			&& fil_try_to_close_file_in_LRU(false);
+
+		mutex_exit(&fil_system->mutex);
+
+		if (!closed) {
+			break;
+		}
+
+		++n_closed;
+	}
+
+	return(n_closed);
+}
+
 /*******************************************************************//**
 Reserves the fil_system mutex and tries to make sure we can open at least one
 file while holding it. This should be called before calling
@@ -4210,6 +4275,90 @@ skip_validate:
 
 	return(err);
 }
+
+/** Register a file-per-table tablespace in the tablespace memory cache
+without opening its data file. This is used at startup instead of
+fil_ibd_open() when no validation is needed. The data file is opened,
+and its space id and flags are checked against the data dictionary, by
+fil_space_open_deferred() when the table is loaded into the dictionary
+cache, or by fil_node_open_file() on an earlier access by space id.
+If the file is missing or belongs to another tablespace, the table is
+marked as missing and i/o on the tablespace fails with
+DB_TABLESPACE_DELETED.
+@param[in]	id		tablespace ID
+@param[in]	flags		tablespace flags
+@param[in]	space_name	tablespace name in databasename/tablename
+format
+@param[in]	path		filepath from the data dictionary
+@return DB_SUCCESS or error code */
+dberr_t
+fil_ibd_open_deferred(
+	ulint		id,
+	ulint		flags,
+	const char*	space_name,
+	const char*	path)
+{
+	ut_ad(!FSP_FLAGS_GET_SHARED(flags));
+	ut_ad(!FSP_FLAGS_GET_ENCRYPTION(flags));
+	ut_ad(!FSP_FLAGS_HAS_DATA_DIR(flags));
+
+	if (!fsp_flags_is_valid(flags)) {
+		return(DB_CORRUPTION);
+	}
+
+	fil_space_t*	space = fil_space_create(
+		space_name, id, flags, FIL_TYPE_TABLESPACE);
+
+	if (space == NULL) {
+		return(DB_ERROR);
+	}
+
+	/* The size is not known until the first page has been read,
+	that is why we pass 0 below. */
+	if (fil_node_create_low(path, 0, space, false, true, false) == NULL) {
+		return(DB_ERROR);
+	}
+
+	mutex_enter(&fil_system->mutex);
+	space->deferred = true;
+	mutex_exit(&fil_system->mutex);
+
+	return(DB_SUCCESS);
+}
+
+/** Open the data file of a tablespace that was registered by
+fil_ibd_open_deferred() and check it against the data dictionary,
+unless that has already been done.
+@param[in]	id	tablespace ID
+@return false if the data file is missing or does not belong to
+the tablespace */
+bool
+fil_space_open_deferred(
+	ulint	id)
+{
+	bool	success = true;
+
+	fil_mutex_enter_and_prepare_for_io(id);
+
+	fil_space_t*	space = fil_space_get_by_id(id);
+
+	if (space != NULL && space->deferred) {
+		ut_a(UT_LIST_GET_LEN(space->chain) == 1);
+
+		fil_node_t*	node = UT_LIST_GET_FIRST(space->chain);
+
+		/* This opens the file and validates its first page. */
+		success = fil_node_prepare_for_io(node, fil_system, space);
+
+		if (success) {
+			fil_node_complete_io(node, fil_system, IORequestRead);
+		}
+	}
+
+	mutex_exit(&fil_system->mutex);
+
+	return(success);
+}
 #endif /* !UNIV_HOTBACKUP */
 
 #ifdef UNIV_HOTBACKUP
@@ -5799,6 +5948,8 @@ fil_io(
 
 		req_type.compression_algorithm(space->compression_type);
 
+		req_type.compression_stats(&space->compression_stats);
+
 	} else {
 		req_type.clear_compressed();
 	}
@@ -6372,14 +6523,41 @@ struct fil_iterator_t {
 	size_t		block_size;		/*!< FS Block Size */
 };
 
+/** Check if any of the pages read in one IO is transparently compressed
+or encrypted. Such pages are only decompressed or decrypted by the IO
+layer when they are read one at a time.
+@param[in]	buf		pages read from the file
+@param[in]	n_pages		number of pages in buf
+@param[in]	page_size	physical page size
+@return true if any page is compressed or encrypted by the IO layer */
+static
+bool
+fil_iterate_has_io_transformed_page(
+	const byte*	buf,
+	ulint		n_pages,
+	ulint		page_size)
+{
+	for (ulint i = 0; i < n_pages; ++i, buf += page_size) {
+		switch (fil_page_get_type(buf)) {
+		case FIL_PAGE_COMPRESSED:
+		case FIL_PAGE_ENCRYPTED:
+		case FIL_PAGE_COMPRESSED_AND_ENCRYPTED:
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
 /********************************************************************//**
-TODO: This can be made parallel trivially by chunking up the file and creating
+TODO: This can be made parallel by chunking up the file and creating
 a callback per thread. Main benefit will be to use multiple CPUs for
 checksums and compressed tables. We have to do compressed tables block by
 block right now. Secondly we need to decompress/compress and copy too much
 of data. These are CPU intensive.
 
-Iterate over all the pages in the tablespace.
+Iterate over all the pages in the tablespace. Ranges of pages that the
+callback reports as free are not read, they are overwritten with zeros.
 @param iter Tablespace iterator
 @param block block to use for IO
 @param callback Callback to inspect and update page contents
@@ -6393,9 +6571,11 @@ fil_iterate(
 	PageCallback&		callback)
 {
 	os_offset_t		offset;
-	ulint			page_no = 0;
+	ulint			n_bytes;
 	ulint			space_id = callback.get_space_id();
-	ulint			n_bytes = iter.n_io_buffers * iter.page_size;
+	ulint			n_io_buffers = iter.n_io_buffers;
+	const ulint		n_pages = static_cast<ulint>(
+		iter.file_size / iter.page_size);
 
 	ut_ad(!srv_read_only_mode);
 
@@ -6406,9 +6586,59 @@ fil_iterate(
 	ulint	read_type = IORequest::READ;
 	ulint	write_type = IORequest::WRITE;
 
+#ifdef HAVE_PSI_STAGE_INTERFACE
+	PSI_stage_progress*	pfs_stage_progress
+		= mysql_set_stage(srv_stage_import_tablespace.m_key);
+#endif /* HAVE_PSI_STAGE_INTERFACE */
+
+	mysql_stage_set_work_estimated(pfs_stage_progress, n_pages);
+	mysql_stage_set_work_completed(pfs_stage_progress, 0);
+
 	for (offset = iter.start; offset < iter.end; offset += n_bytes) {
 
 		byte*	io_buffer = iter.io_buffer;
+		ulint	page_no = static_cast<ulint>(offset / iter.page_size);
+
+		mysql_stage_set_work_completed(pfs_stage_progress, page_no);
+
+		/* We have to read the exact number of bytes. Otherwise the
+		InnoDB IO functions croak on failed reads. */
+
+		n_bytes = static_cast<ulint>(
+			ut_min(static_cast<os_offset_t>(
+				       n_io_buffers * iter.page_size),
+			       iter.end - offset));
+
+		ut_ad(n_bytes > 0);
+		ut_ad(!(n_bytes % iter.page_size));
+
+		ulint	n_pages_read = n_bytes / iter.page_size;
+
+		if (callback.is_free_range(page_no, n_pages_read)) {
+
+			/* Do not read and convert free pages, but do not
+			leave the page LSN and space id of the exporting
+			server on them either: recovery would skip the
+			redo of a reallocated page whose stale LSN is
+			newer. An all-zero page is a valid fresh page. */
+			IORequest	zero_request(IORequest::WRITE);
+			zero_request.block_size(iter.block_size);
+
+			memset(iter.io_buffer, 0, n_bytes);
+
+			dberr_t	err = os_file_write(
+				zero_request, iter.filepath, iter.file,
+				iter.io_buffer, offset, n_bytes);
+
+			if (err != DB_SUCCESS) {
+
+				ib::error() << "os_file_write() failed";
+
+				return(err);
+			}
+
+			continue;
+		}
 
 		block->frame = io_buffer;
 
@@ -6432,16 +6662,6 @@ fil_iterate(
 			io_buffer = iter.io_buffer;
 		}
 
-		/* We have to read the exact number of bytes. Otherwise the
-		InnoDB IO functions croak on failed reads. */
-
-		n_bytes = static_cast<ulint>(
-			ut_min(static_cast<os_offset_t>(n_bytes),
-			       iter.end - offset));
-
-		ut_ad(n_bytes > 0);
-		ut_ad(!(n_bytes % iter.page_size));
-
 		dberr_t		err;
 		IORequest	read_request(read_type);
 		read_request.block_size(iter.block_size);
@@ -6465,9 +6685,21 @@ fil_iterate(
 			return(err);
 		}
 
+		/* The IO layer only handles the first page of a read, fall
+		back to reading page by page if the file has pages that it
+		must decompress or decrypt. */
+
+		if (n_pages_read > 1
+		    && fil_iterate_has_io_transformed_page(
+			    io_buffer, n_pages_read, iter.page_size)) {
+
+			n_io_buffers = 1;
+			n_bytes = 0;
+			continue;
+		}
+
 		bool		updated = false;
 		os_offset_t	page_off = offset;
-		ulint		n_pages_read = (ulint) n_bytes / iter.page_size;
 
 		for (ulint i = 0; i < n_pages_read; ++i) {
 
@@ -6525,6 +6757,8 @@ fil_iterate(
 		}
 	}
 
+	mysql_stage_set_work_completed(pfs_stage_progress, n_pages);
+
 	return(DB_SUCCESS);
 }
 
@@ -6599,6 +6833,16 @@ fil_tablespace_iterate(
 		err = DB_SUCCESS;
 	}
 
+#ifndef _WIN32
+	/* Every page is read and written once, do not pollute the file
+	system cache with them. */
+	if (srv_unix_file_flush_method == SRV_UNIX_O_DIRECT
+	    || srv_unix_file_flush_method == SRV_UNIX_O_DIRECT_NO_FSYNC) {
+
+		os_file_set_nocache(file.m_file, filepath, "open");
+	}
+#endif /* !_WIN32 */
+
 	/* Set File System Block Size */
 	size_t block_size;
 	{
@@ -6683,12 +6927,16 @@ fil_tablespace_iterate(
 		if (err == DB_SUCCESS) {
 
 			/* Compressed pages can't be optimised for block IO
-			for now.  We do the IMPORT page by page. */
+			for now.  We do the IMPORT page by page. The IO layer
+			decrypts only one page per read, so do the same for
+			encrypted tablespaces. */
 
 			if (callback.get_page_size().is_compressed()) {
 				iter.n_io_buffers = 1;
 				ut_a(iter.page_size
 				     == callback.get_page_size().physical());
+			} else if (FSP_FLAGS_GET_ENCRYPTION(space_flags)) {
+				iter.n_io_buffers = 1;
 			}
 
 			/** Add an extra page for compressed page scratch
@@ -7358,6 +7606,44 @@ fil_get_compression(
 	return(space == NULL ? Compression::NONE : space->compression_type);
 }
 
+/** Print the transparent page compression statistics of the tablespaces
+that have had pages written with compression enabled.
+@param[in,out]	file	file where to print */
+void
+fil_print_compression_stats(
+	FILE*		file)
+{
+	mutex_enter(&fil_system->mutex);
+
+	for (const fil_space_t* space
+		= UT_LIST_GET_FIRST(fil_system->space_list);
+	     space != NULL;
+	     space = UT_LIST_GET_NEXT(space_list, space)) {
+
+		const Compression_stats&	stats = space->compression_stats;
+
+		if (stats.m_bytes_in == 0 && stats.m_n_skipped == 0) {
+			continue;
+		}
+
+		fprintf(file,
+			"Page compression %s: " ULINTPF " compressed, "
+			ULINTPF " failed, " ULINTPF " skipped, %.2f%% saved, "
+			ULINTPF " ms\n",
+			space->name,
+			stats.m_n_compressed,
+			stats.m_n_failed,
+			stats.m_n_skipped,
+			stats.m_bytes_in == 0
+			? 0.0
+			: 100.0 * (double) (stats.m_bytes_in - stats.m_bytes_out)
+			/ (double) stats.m_bytes_in,
+			stats.m_time_us / 1000);
+	}
+
+	mutex_exit(&fil_system->mutex);
+}
+
 /** Set the encryption type for the tablespace
 @param[in] space_id		Space ID of tablespace for which to set
 @param[in] algorithm		Encryption algorithm
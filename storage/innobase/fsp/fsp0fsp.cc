@@ -1556,6 +1556,26 @@ fsp_try_extend_data_file(
 	return(true);
 }
 
+/** Calculate how many extents are added at a time to FSP_FREE from above
+FSP_FREE_LIMIT. This is FSP_FREE_ADD, or 1/16 of the size of a big
+tablespace, capped at FSP_FREE_ADD_MAX. Adding more extents to a big
+tablespace at a time means that inserts into it extend the file and
+refill FSP_FREE less often while they hold the space latch.
+@param[in]	page_size	page size of the tablespace
+@param[in]	size		current number of pages in the tablespace
+@return number of extents */
+static
+ulint
+fsp_get_n_free_add(
+	const page_size_t&	page_size,
+	ulint			size)
+{
+	ulint	n_extents = size / fsp_get_extent_size_in_pages(page_size);
+
+	return(ut_min(ut_max(n_extents / 16, ulint(FSP_FREE_ADD)),
+		      ulint(FSP_FREE_ADD_MAX)));
+}
+
 /** Calculate the number of pages to extend a datafile.
 We extend single-table and general tablespaces first one extent at a time,
 but 4 at a time for bigger tablespaces. It is not enough to extend always
@@ -1590,9 +1610,10 @@ fsp_get_pages_to_extend_ibd(
 	} else {
                 // 如果当前表空间中的页大于等于32 * 64页，那么增加FSP_FREE_ADD个区，也就是4个区
 		/* Below in fsp_fill_free_list() we assume
-		that we add at most FSP_FREE_ADD extents at
-		a time */
-		size_increase = FSP_FREE_ADD * extent_size;
+		that we add at most fsp_get_n_free_add() extents
+		at a time */
+		size_increase = fsp_get_n_free_add(page_size, size)
+			* extent_size;
 	}
 
 	return(size_increase);
@@ -1636,8 +1657,9 @@ fsp_fill_free_list(
 	ut_ad(flags == space->flags);
 
 	const page_size_t	page_size(flags);
+	const ulint		n_free_add = fsp_get_n_free_add(page_size, size);
         // size表示当前表空间中有多少页，如果当前页数小于
-	if (size < limit + FSP_EXTENT_SIZE * FSP_FREE_ADD) {
+	if (size < limit + FSP_EXTENT_SIZE * n_free_add) {
                 // 如果当前不是初始化表空间才考虑分配空闲区
 		if ((!init_space && !is_system_tablespace(space->id))
 		    || (space->id == srv_sys_space.space_id()
@@ -1656,7 +1678,7 @@ fsp_fill_free_list(
         // 如果是初始化表空间，则直接进去
         // 如果不是初始化表空间，需要分配区时，会判断当前表空间中有多少页size，如果size>=
 	while ((init_space && i < 1)
-	       || ((i + FSP_EXTENT_SIZE <= size) && (count < FSP_FREE_ADD))) {
+	       || ((i + FSP_EXTENT_SIZE <= size) && (count < n_free_add))) {
 
                 // 新增的这个区是不是这一组里的第一个区
 		bool	init_xdes
@@ -2886,7 +2908,8 @@ fseg_n_reserved_pages(
 /** Tries to fill the free list of a segment with consecutive free extents.
 This happens if the segment is big enough to allow extents in the free list,
 the free list is empty, and the extents can be allocated consecutively from
-the hint onward.
+the hint onward. A big segment reserves up to 1/16 of its size at a time, so
+that it takes extents from FSP_FREE less often.
 @param[in]	inode		segment inode
 @param[in]	space		space id
 @param[in]	page_size	page size
@@ -2927,8 +2950,13 @@ fseg_fill_free_list(
 		return;
 	}
 
+	const ulint	n_max = ut_min(
+		ut_max(reserved / FSP_EXTENT_SIZE / 16,
+		       ulint(FSEG_FREE_LIST_MAX_LEN)),
+		ulint(FSEG_FREE_LIST_MAX_LEN_LARGE));
+
         // 一个段填充四个空闲区
-	for (i = 0; i < FSEG_FREE_LIST_MAX_LEN; i++) {
+	for (i = 0; i < n_max; i++) {
 		descr = xdes_get_descriptor(space, hint, page_size, mtr);
 
 		if ((descr == NULL)
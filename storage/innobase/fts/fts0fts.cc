@@ -1130,6 +1130,7 @@ fts_get_index_cache(
 	ulint			i;
 
 	ut_ad(rw_lock_own((rw_lock_t*) &cache->lock, RW_LOCK_X)
+	      || rw_lock_own((rw_lock_t*) &cache->lock, RW_LOCK_S)
 	      || rw_lock_own((rw_lock_t*) &cache->init_lock, RW_LOCK_X));
 
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
@@ -5790,7 +5791,8 @@ fts_cache_find_word(
 	dict_table_t*		table = index_cache->index->table;
 	fts_cache_t*		cache = table->fts->cache;
 
-	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X)
+	      || rw_lock_own(&cache->lock, RW_LOCK_S));
 #endif /* UNIV_DEBUG */
 
 	/* Lookup the word in the rb tree */
@@ -111,9 +111,12 @@ struct fts_query_t {
 					the new doc_ids, elements are of type
 					fts_ranking_t */
 
-					/*!< Prepared statement to read the
-					nodes from the FTS INDEX */
-	que_t*		read_nodes_graph;
+					/*!< Prepared statements to read the
+					nodes from the FTS INDEX, one per
+					auxiliary table, kept for the whole
+					query so that each statement is
+					parsed at most once */
+	que_t*		read_nodes_graph[FTS_NUM_AUX_INDEX];
 
 	fts_ast_oper_t	oper;		/*!< Current boolean mode operator */
 
@@ -1114,6 +1117,31 @@ cont_search:
 	return(num_word);
 }
 
+/*****************************************************************//**
+Read the nodes of a word from the FTS INDEX. The prepared statement for
+the auxiliary table the word maps to is cached in the query, so that a
+query touching many words does not parse the same SQL again and again.
+@return DB_SUCCESS if all go well else error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_query_fetch_nodes(
+/*==================*/
+	fts_query_t*		query,	/*!< in: query instance */
+	const fts_string_t*	token,	/*!< in: token to search */
+	fts_fetch_t*		fetch)	/*!< in: fetch callback */
+{
+	ulint	selected;
+
+	selected = fts_select_index(
+		query->fts_index_table.charset, token->f_str, token->f_len);
+
+	query->fts_index_table.suffix = fts_get_suffix(selected);
+
+	return(fts_index_fetch_nodes(
+		query->trx, &query->read_nodes_graph[selected],
+		&query->fts_index_table, token, fetch));
+}
+
 /*****************************************************************//**
 Set difference.
 @return DB_SUCCESS if all go well */
@@ -1125,7 +1153,6 @@ fts_query_difference(
 	const fts_string_t*	token)	/*!< in: token to search */
 {
 	ulint			n_doc_ids= 0;
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_IGNORE);
@@ -1149,11 +1176,10 @@ fts_query_difference(
 		fts_fetch_t		fetch;
 		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
-		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
 		dberr_t			error;
 
-		rw_lock_x_lock(&cache->lock);
+		rw_lock_s_lock(&cache->lock);
 
 		index_cache = fts_find_index_cache(cache, query->index);
 
@@ -1179,7 +1205,7 @@ fts_query_difference(
 			}
 		}
 
-		rw_lock_x_unlock(&cache->lock);
+		rw_lock_s_unlock(&cache->lock);
 
 		/* error is passed by 'query->error' */
 		if (query->error != DB_SUCCESS) {
@@ -1192,16 +1218,13 @@ fts_query_difference(
 		fetch.read_arg = query;
 		fetch.read_record = fts_query_index_fetch_nodes;
 
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, token, &fetch);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
 		if (error != DB_SUCCESS) {
 			query->error = error;
 		}
-
-		fts_que_graph_free(graph);
 	}
 
 	/* The size can't increase. */
@@ -1220,7 +1243,6 @@ fts_query_intersect(
 	fts_query_t*		query,	/*!< in: query instance */
 	const fts_string_t*	token)	/*!< in: the token to search */
 {
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_EXIST);
@@ -1242,7 +1264,6 @@ fts_query_intersect(
 		fts_fetch_t		fetch;
 		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
-		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
 		dberr_t			error;
 
@@ -1278,7 +1299,7 @@ fts_query_intersect(
 
 		/* Search the cache for a matching word first. */
 
-		rw_lock_x_lock(&cache->lock);
+		rw_lock_s_lock(&cache->lock);
 
 		/* Search for the index specific cache. */
 		index_cache = fts_find_index_cache(cache, query->index);
@@ -1303,7 +1324,7 @@ fts_query_intersect(
 			}
 		}
 
-		rw_lock_x_unlock(&cache->lock);
+		rw_lock_s_unlock(&cache->lock);
 
 		/* error is passed by 'query->error' */
 		if (query->error != DB_SUCCESS) {
@@ -1316,8 +1337,7 @@ fts_query_intersect(
 		fetch.read_arg = query;
 		fetch.read_record = fts_query_index_fetch_nodes;
 
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, token, &fetch);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1325,8 +1345,6 @@ fts_query_intersect(
 			query->error = error;
 		}
 
-		fts_que_graph_free(graph);
-
 		if (query->error == DB_SUCCESS) {
 			/* Make the intesection (rb tree) the current doc id
 			set and free the old set. */
@@ -1357,7 +1375,7 @@ fts_query_cache(
 	fts_cache_t*		cache = table->fts->cache;
 
 	/* Search the cache for a matching word first. */
-	rw_lock_x_lock(&cache->lock);
+	rw_lock_s_lock(&cache->lock);
 
 	/* Search for the index specific cache. */
 	index_cache = fts_find_index_cache(cache, query->index);
@@ -1387,7 +1405,7 @@ fts_query_cache(
 		}
 	}
 
-	rw_lock_x_unlock(&cache->lock);
+	rw_lock_s_unlock(&cache->lock);
 
 	return(query->error);
 }
@@ -1404,8 +1422,6 @@ fts_query_union(
 {
 	fts_fetch_t		fetch;
 	ulint			n_doc_ids = 0;
-	trx_t*			trx = query->trx;
-	que_t*			graph = NULL;
 	dberr_t			error;
 
 	ut_a(query->oper == FTS_NONE || query->oper == FTS_DECR_RATING ||
@@ -1436,8 +1452,7 @@ fts_query_union(
 	fetch.read_record = fts_query_index_fetch_nodes;
 
 	/* Read the nodes from disk. */
-	error = fts_index_fetch_nodes(
-		trx, &graph, &query->fts_index_table, token, &fetch);
+	error = fts_query_fetch_nodes(query, token, &fetch);
 
 	/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 	ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1445,8 +1460,6 @@ fts_query_union(
 		query->error = error;
 	}
 
-	fts_que_graph_free(graph);
-
 	if (query->error == DB_SUCCESS) {
 
 		/* The size can't decrease. */
@@ -2488,9 +2501,9 @@ fts_query_is_in_proximity_range(
 
 	memset(&get_doc, 0x0, sizeof(get_doc));
 
-	rw_lock_x_lock(&cache->lock);
+	rw_lock_s_lock(&cache->lock);
 	get_doc.index_cache = fts_find_index_cache(cache, query->index);
-	rw_lock_x_unlock(&cache->lock);
+	rw_lock_s_unlock(&cache->lock);
 	ut_a(get_doc.index_cache != NULL);
 
 	fts_phrase_t	phrase(get_doc.index_cache->index->table);
@@ -2548,14 +2561,14 @@ fts_query_search_phrase(
 	/* Setup the doc retrieval infrastructure. */
 	memset(&get_doc, 0x0, sizeof(get_doc));
 
-	rw_lock_x_lock(&cache->lock);
+	rw_lock_s_lock(&cache->lock);
 
 	get_doc.index_cache = fts_find_index_cache(cache, query->index);
 
 	/* Must find the index cache */
 	ut_a(get_doc.index_cache != NULL);
 
-	rw_lock_x_unlock(&cache->lock);
+	rw_lock_s_unlock(&cache->lock);
 
 #ifdef FTS_INTERNAL_DIAG_PRINT
 	ib::info() << "Start phrase search";
@@ -2756,9 +2769,7 @@ fts_query_phrase_search(
 	if (num_token > 0) {
 		fts_string_t*	token;
 		fts_fetch_t	fetch;
-		trx_t*		trx = query->trx;
 		fts_ast_oper_t	oper = query->oper;
-		que_t*		graph = NULL;
 		ulint		i;
 		dberr_t		error;
 
@@ -2808,9 +2819,7 @@ fts_query_phrase_search(
 				query->matched = query->match_array[i];
 			}
 
-			error = fts_index_fetch_nodes(
-				trx, &graph, &query->fts_index_table,
-				token, &fetch);
+			error = fts_query_fetch_nodes(query, token, &fetch);
 
 			/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 			ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -2818,9 +2827,6 @@ fts_query_phrase_search(
 				query->error = error;
 			}
 
-			fts_que_graph_free(graph);
-			graph = NULL;
-
 			fts_query_cache(query, token);
 
 			if (!(query->flags & FTS_PHRASE)
@@ -3236,6 +3242,15 @@ fts_query_filter_doc_ids(
 	doc_id_t	doc_id = 0;
 	ulint		decoded = 0;
 	ib_rbt_t*	doc_freqs = word_freq->doc_freqs;
+	/* In a '+a +b' intersection only the doc ids that are already
+	in query->doc_ids can survive. The ilist is sorted on doc id, so
+	doc ids outside [lower_doc_id, upper_doc_id] need not be processed,
+	and the rest of the ilist can be skipped once upper_doc_id has been
+	passed, unless the doc ids must still be counted for ranking. */
+	const bool	in_range_only = query->oper == FTS_EXIST
+		&& query->multi_exist
+		&& query->upper_doc_id > 0
+		&& !query->collect_positions;
 
 	if (query->limit != ULONG_UNDEFINED
 	    && query->n_docs >= query->limit) {
@@ -3249,6 +3264,7 @@ fts_query_filter_doc_ids(
 		fts_match_t*	match = NULL;
 		ulint		last_pos = 0;
 		ulint		pos = fts_decode_vlc(&ptr);
+		bool		skip;
 
 		/* Some sanity checks. */
 		if (doc_id == 0) {
@@ -3258,6 +3274,15 @@ fts_query_filter_doc_ids(
 		/* Add the delta. */
 		doc_id += pos;
 
+		skip = in_range_only
+			&& (doc_id < query->lower_doc_id
+			    || doc_id > query->upper_doc_id);
+
+		if (skip && !calc_doc_count
+		    && doc_id > query->upper_doc_id) {
+			goto func_exit;
+		}
+
 		if (calc_doc_count) {
 			word_freq->doc_count++;
 		}
@@ -3305,6 +3330,16 @@ fts_query_filter_doc_ids(
 			ib_vector_push(match->positions, &last_pos);
 		}
 
+		/* Skip the end of word position marker. */
+		++ptr;
+
+		/* Bytes decoded so far */
+		decoded = ptr - (byte*) data;
+
+		if (skip) {
+			continue;
+		}
+
 		/* Add the doc id to the doc freq rb tree, if the doc id
 		doesn't exist it will be created. */
 		doc_freq = fts_query_add_doc_freq(query, doc_freqs, doc_id);
@@ -3314,12 +3349,6 @@ fts_query_filter_doc_ids(
 			doc_freq->freq = freq;
 		}
 
-		/* Skip the end of word position marker. */
-		++ptr;
-
-		/* Bytes decoded so far */
-		decoded = ptr - (byte*) data;
-
 		/* We simply collect the matching documents and the
 		positions here and match later. */
 		if (!query->collect_positions) {
@@ -3811,8 +3840,10 @@ fts_query_free(
 	fts_query_t*	query)		/*!< in: query instance to free*/
 {
 
-	if (query->read_nodes_graph) {
-		fts_que_graph_free(query->read_nodes_graph);
+	for (ulint i = 0; i < FTS_NUM_AUX_INDEX; ++i) {
+		if (query->read_nodes_graph[i]) {
+			fts_que_graph_free(query->read_nodes_graph[i]);
+		}
 	}
 
 	if (query->root) {
@@ -4317,9 +4348,9 @@ fts_expand_query(
 	/* Init "result_doc", to hold words from the first search pass */
 	fts_doc_init(&result_doc);
 
-	rw_lock_x_lock(&index->table->fts->cache->lock);
+	rw_lock_s_lock(&index->table->fts->cache->lock);
 	index_cache = fts_find_index_cache(index->table->fts->cache, index);
-	rw_lock_x_unlock(&index->table->fts->cache->lock);
+	rw_lock_s_unlock(&index->table->fts->cache->lock);
 
 	ut_a(index_cache);
 
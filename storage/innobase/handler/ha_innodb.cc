@@ -921,6 +921,14 @@ static SHOW_VAR innodb_status_variables[] = {
         "dblwr_writes",
         (char *) &export_vars.innodb_dblwr_writes, SHOW_LONG, SHOW_SCOPE_GLOBAL
     },
+    {
+        "ibuf_merge_time",
+        (char *) &export_vars.innodb_ibuf_merge_time, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "ibuf_merges",
+        (char *) &export_vars.innodb_ibuf_merges, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
     {
         "log_waits",
         (char *) &export_vars.innodb_log_waits, SHOW_LONG, SHOW_SCOPE_GLOBAL
@@ -949,6 +957,26 @@ static SHOW_VAR innodb_status_variables[] = {
         "os_log_written",
         (char *) &export_vars.innodb_os_log_written, SHOW_LONGLONG, SHOW_SCOPE_GLOBAL
     },
+    {
+        "page_compression_compressed",
+        (char *) &export_vars.innodb_page_compression_compressed, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "page_compression_failed",
+        (char *) &export_vars.innodb_page_compression_failed, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "page_compression_saved",
+        (char *) &export_vars.innodb_page_compression_saved, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "page_compression_skipped",
+        (char *) &export_vars.innodb_page_compression_skipped, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "page_compression_time",
+        (char *) &export_vars.innodb_page_compression_time, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
     {
         "page_size",
         (char *) &export_vars.innodb_page_size, SHOW_LONG, SHOW_SCOPE_GLOBAL
@@ -1001,6 +1029,14 @@ static SHOW_VAR innodb_status_variables[] = {
         "rows_updated",
         (char *) &export_vars.innodb_rows_updated, SHOW_LONG, SHOW_SCOPE_GLOBAL
     },
+    {
+        "thread_concurrency_wait_time",
+        (char *) &export_vars.innodb_thread_concurrency_wait_time, SHOW_LONGLONG, SHOW_SCOPE_GLOBAL
+    },
+    {
+        "thread_concurrency_waits",
+        (char *) &export_vars.innodb_thread_concurrency_waits, SHOW_LONG, SHOW_SCOPE_GLOBAL
+    },
     {
         "num_open_files",
         (char *) &export_vars.innodb_num_open_files, SHOW_LONG, SHOW_SCOPE_GLOBAL
@@ -7497,6 +7533,34 @@ ha_innobase::intrinsic_table_write_row(uchar *record) {
         err, m_prebuilt->table->flags, m_user_thd));
 }
 
+/** Prepare for a multi-row insert. The rows of the batch are still
+inserted one by one, but each row first tries the clustered index leaf
+page that received the previous row, so that rows landing on the same
+page do not pay for a B-tree descent each.
+@param[in]	rows	number of rows to be inserted, or 0 if unknown */
+void
+ha_innobase::start_bulk_insert(ha_rows rows) {
+    DBUG_ENTER("ha_innobase::start_bulk_insert");
+
+    m_prebuilt->ins_hint.block.clear();
+    m_prebuilt->ins_batch = rows != 1
+        && !dict_table_is_intrinsic(m_prebuilt->table);
+
+    DBUG_VOID_RETURN;
+}
+
+/** End of a multi-row insert started with start_bulk_insert().
+@return 0 */
+int
+ha_innobase::end_bulk_insert() {
+    DBUG_ENTER("ha_innobase::end_bulk_insert");
+
+    m_prebuilt->ins_batch = false;
+    m_prebuilt->ins_hint.block.clear();
+
+    DBUG_RETURN(0);
+}
+
 /********************************************************************/ /**
 Stores a row in an InnoDB database, to the table specified in this
 handle.
@@ -15336,6 +15400,9 @@ ha_innobase::end_stmt() {
     /* This is a statement level counter. */
     m_prebuilt->autoinc_last_value = 0;
 
+    /* A multi-row insert never spans statements. */
+    m_prebuilt->ins_batch = false;
+
     /* This transaction had called ha_innobase::start_stmt() */
     trx_t *trx = m_prebuilt->trx;
     if (!dict_table_is_temporary(m_prebuilt->table) &&
@@ -16858,6 +16925,23 @@ ha_innobase::cmp_ref(
     return (0);
 }
 
+/*******************************************************************/ /**
+Reads ahead the clustered index leaf pages of a batch of rows that
+DS-MRR is about to fetch with rnd_pos(). */
+
+void
+ha_innobase::prefetch_rowids(
+    /*========================*/
+    const uchar *rowids, /*!< in: the first 'ref' */
+    size_t n_rowids, /*!< in: number of 'refs' */
+    uint step) /*!< in: distance in bytes between two 'refs' */
+{
+    TrxInInnoDB trx_in_innodb(m_prebuilt->trx);
+
+    row_sel_prefetch_clust_leaves_for_mysql(
+        m_prebuilt, rowids, n_rowids, ref_length, step);
+}
+
 /*******************************************************************/ /**
 Ask InnoDB if a query to a table can be cached.
 @return TRUE if query caching of the table is permitted */
@@ -19076,6 +19160,33 @@ buffer_pool_load_abort(
     }
 }
 
+/****************************************************************/ /**
+Update the system variable innodb_buffer_pool_dump_interval using the
+"saved" value and wake up the buffer pool dump thread, so that it starts
+waiting for the new interval. This function is registered as a callback
+with MySQL. */
+static
+void
+innodb_buffer_pool_dump_interval_update(
+    /*====================================*/
+    THD *thd /*!< in: thread handle */
+    MY_ATTRIBUTE((unused)),
+    struct st_mysql_sys_var *var /*!< in: pointer to system
+						variable */
+    MY_ATTRIBUTE((unused)),
+    void *var_ptr /*!< out: where the formal
+						string goes */
+    MY_ATTRIBUTE((unused)),
+    const void *save) /*!< in: immediate result from
+						check function */
+{
+    srv_buf_dump_interval = *static_cast<const ulong *>(save);
+
+    if (!srv_read_only_mode) {
+        os_event_set(srv_buf_dump_event);
+    }
+}
+
 /****************************************************************/ /**
 Update the system variable innodb_log_write_ahead_size using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -19479,6 +19590,12 @@ static MYSQL_SYSVAR_BOOL(stats_auto_recalc, srv_stats_auto_recalc,
                          " new statistics)",
                          NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(stats_threads, srv_n_stats_threads,
+                          PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+                          "Number of background threads that recalculate persistent"
+                          " statistics of tables that have changed too much. Default is 1.",
+                          NULL, NULL, 1, 1, 32, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
                               srv_stats_persistent_sample_pages,
                               PLUGIN_VAR_RQCMDARG,
@@ -19602,6 +19719,11 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
                           "Dump only the hottest N% of each buffer pool, defaults to 25",
                           NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval, srv_buf_dump_interval,
+                          PLUGIN_VAR_RQCMDARG,
+                          "Dump the buffer pool in the background every N seconds, 0 disables the periodic dump",
+                          NULL, innodb_buffer_pool_dump_interval_update, 0, 0, 3600, 0);
+
 #ifdef UNIV_DEBUG
 static MYSQL_SYSVAR_STR(buffer_pool_evict, srv_buffer_pool_evict,
                         PLUGIN_VAR_RQCMDARG,
@@ -19793,6 +19915,14 @@ static MYSQL_SYSVAR_LONG(open_files, innobase_open_files,
                          "How many files at the maximum InnoDB keeps open at the same time.",
                          NULL, NULL, 0L, 0L, LONG_MAX, 0);
 
+static MYSQL_SYSVAR_BOOL(validate_tablespace_paths,
+  srv_validate_tablespace_paths,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Check the location of every file-per-table tablespace at startup"
+  " (enabled by default). When disabled and no crash recovery is needed,"
+  " the data files are opened on first access.",
+  NULL, NULL, TRUE);
+
 static MYSQL_SYSVAR_ULONG(sync_spin_loops, srv_n_spin_wait_rounds,
                           PLUGIN_VAR_RQCMDARG,
                           "Count of spin-loop rounds in InnoDB mutexes (30 by default)",
@@ -19811,7 +19941,9 @@ static MYSQL_SYSVAR_ULONG(thread_concurrency, srv_thread_concurrency,
 static MYSQL_SYSVAR_ULONG(
     adaptive_max_sleep_delay, srv_adaptive_max_sleep_delay,
     PLUGIN_VAR_RQCMDARG,
-    "The upper limit of the sleep delay in usec. Value of 0 disables it.",
+    "The upper limit in usec of innodb_thread_sleep_delay, the interval at"
+    " which a thread waiting to enter InnoDB re-checks"
+    " innodb_thread_concurrency. Value of 0 disables it.",
     NULL, NULL,
     150000, /* Default setting */
     0, /* Minimum value */
@@ -19819,8 +19951,9 @@ static MYSQL_SYSVAR_ULONG(
 
 static MYSQL_SYSVAR_ULONG(thread_sleep_delay, srv_thread_sleep_delay,
                           PLUGIN_VAR_RQCMDARG,
-                          "Time of innodb thread sleeping before joining InnoDB queue (usec)."
-                          " Value 0 disable a sleep",
+                          "Interval at which a thread waiting in the InnoDB queue re-checks"
+                          " innodb_thread_concurrency (usec). Waiting threads are woken up"
+                          " as soon as a place becomes free.",
                           NULL, NULL,
                           10000L,
                           0L,
@@ -19960,6 +20093,13 @@ static MYSQL_SYSVAR_UINT(change_buffer_max_size,
                          NULL, innodb_change_buffer_max_size_update,
                          CHANGE_BUFFER_DEFAULT_SIZE, 0, 50, 0);
 
+static MYSQL_SYSVAR_ULONG(change_buffer_merge_pct,
+                          srv_change_buffer_merge_pct,
+                          PLUGIN_VAR_RQCMDARG,
+                          "Percentage of innodb_io_capacity used for merging the change buffer"
+                          " in the background while the server is active.",
+                          NULL, NULL, 5, 1, 100, 0);
+
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
                          PLUGIN_VAR_RQCMDARG,
                          "Specifies how InnoDB index statistics collection code should"
@@ -20047,6 +20187,14 @@ static MYSQL_SYSVAR_ULONG(compression_pad_pct_max,
                           " to make the page compressible.",
                           NULL, NULL, 50, 0, 75, 0);
 
+static MYSQL_SYSVAR_ULONG(page_compression_min_saving_pct,
+                          srv_page_compression_min_saving_pct, PLUGIN_VAR_OPCMDARG,
+                          "Minimum percentage of a page that transparent page compression must"
+                          " save for the page to be written compressed. Tables whose pages"
+                          " repeatedly compress worse than this are periodically written without"
+                          " trying to compress them. A value of zero disables the check.",
+                          NULL, NULL, 0, 0, 99, 0);
+
 static MYSQL_SYSVAR_BOOL(read_only, srv_read_only_mode,
                          PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
                          "Start InnoDB in read only mode (off by default)",
@@ -20134,6 +20282,7 @@ static struct st_mysql_sys_var *innobase_system_variables[] = {
     MYSQL_SYSVAR(buffer_pool_dump_now),
     MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
     MYSQL_SYSVAR(buffer_pool_dump_pct),
+    MYSQL_SYSVAR(buffer_pool_dump_interval),
 #ifdef UNIV_DEBUG
     MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -20202,6 +20351,7 @@ static struct st_mysql_sys_var *innobase_system_variables[] = {
     MYSQL_SYSVAR(old_blocks_pct),
     MYSQL_SYSVAR(old_blocks_time),
     MYSQL_SYSVAR(open_files),
+    MYSQL_SYSVAR(validate_tablespace_paths),
     MYSQL_SYSVAR(optimize_fulltext_only),
     MYSQL_SYSVAR(rollback_on_timeout),
     MYSQL_SYSVAR(ft_aux_table),
@@ -20215,6 +20365,7 @@ static struct st_mysql_sys_var *innobase_system_variables[] = {
     MYSQL_SYSVAR(stats_persistent),
     MYSQL_SYSVAR(stats_persistent_sample_pages),
     MYSQL_SYSVAR(stats_auto_recalc),
+    MYSQL_SYSVAR(stats_threads),
     MYSQL_SYSVAR(adaptive_hash_index),
     MYSQL_SYSVAR(adaptive_hash_index_parts),
     MYSQL_SYSVAR(stats_method),
@@ -20239,6 +20390,7 @@ static struct st_mysql_sys_var *innobase_system_variables[] = {
 #endif /* HAVE_LIBNUMA */
     MYSQL_SYSVAR(change_buffering),
     MYSQL_SYSVAR(change_buffer_max_size),
+    MYSQL_SYSVAR(change_buffer_merge_pct),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
     MYSQL_SYSVAR(change_buffering_debug),
     MYSQL_SYSVAR(disable_background_merge),
@@ -20282,6 +20434,7 @@ static struct st_mysql_sys_var *innobase_system_variables[] = {
     MYSQL_SYSVAR(sync_array_size),
     MYSQL_SYSVAR(compression_failure_threshold_pct),
     MYSQL_SYSVAR(compression_pad_pct_max),
+    MYSQL_SYSVAR(page_compression_min_saving_pct),
     MYSQL_SYSVAR(default_row_format),
 #ifdef UNIV_DEBUG
     MYSQL_SYSVAR(trx_rseg_n_slots_debug),
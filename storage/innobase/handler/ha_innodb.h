@@ -132,6 +132,10 @@ public:
 
 	longlong get_memory_buffer_size() const;
 
+	void start_bulk_insert(ha_rows rows);
+
+	int end_bulk_insert();
+
 	int write_row(uchar * buf);
 
 	int update_row(const uchar * old_data, uchar * new_data);
@@ -293,6 +297,11 @@ public:
 
 	int cmp_ref(const uchar* ref1, const uchar* ref2);
 
+	void prefetch_rowids(
+		const uchar*	rowids,
+		size_t		n_rowids,
+		uint		step);
+
 	/** On-line ALTER TABLE interface @see handler0alter.cc @{ */
 
 	/** Check if InnoDB supports a particular alter table in-place
@@ -2714,8 +2714,9 @@ ibuf_merge_in_background(
 		/* Caller has requested a full batch */
 		n_pages = PCT_IO(100);
 	} else {
-		/* By default we do a batch of 5% of the io_capacity */
-		n_pages = PCT_IO(5);
+		/* By default we do a batch of innodb_change_buffer_merge_pct
+		(5%) of the io_capacity */
+		n_pages = PCT_IO(srv_change_buffer_merge_pct);
 
 		mutex_enter(&ibuf_mutex);
 
@@ -4521,6 +4522,8 @@ ibuf_merge_or_delete_for_page(
 		return;
 	}
 
+	const ib_time_monotonic_us_t	start_time = ut_time_monotonic_us();
+
 	heap = mem_heap_create(512);
 
 	search_tuple = ibuf_search_tuple_build(
@@ -4778,6 +4781,8 @@ reset_bit:
 	ibuf_add_ops(ibuf->n_merged_ops, mops);
 	ibuf_add_ops(ibuf->n_discarded_ops, dops);
 
+	srv_stats.ibuf_merge_time.add(ut_time_monotonic_us() - start_time);
+
 	if (space != NULL) {
 		fil_space_release(space);
 	}
@@ -72,6 +72,7 @@ struct btr_latch_leaves_t {
 #include "que0types.h"
 #include "row0types.h"
 #include "ha0ha.h"
+#include "buf0block_hint.h"
 
 #ifdef UNIV_DEBUG
 /*********************************************************//**
@@ -197,6 +198,41 @@ btr_cur_search_to_nth_level(
 	ulint		line,	/*!< in: line where called */
 	mtr_t*		mtr);	/*!< in: mtr */
 
+/** Positions a tree cursor on the leaf page remembered in a hint, such as
+the page that received the previous insert of a multi-row batch, without
+descending the tree. The cursor is positioned with PAGE_CUR_LE only if
+the tuple is known to belong on the hinted page; otherwise nothing is
+latched and the caller must fall back to btr_cur_search_to_nth_level().
+@param[in,out]	hint		leaf page of the previous search
+@param[in]	index		clustered index
+@param[in]	tuple		search tuple
+@param[in]	latch_mode	BTR_MODIFY_LEAF or BTR_SEARCH_LEAF
+@param[out]	cursor		tree cursor; the leaf page is latched
+				on success
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return true if the cursor was positioned on the hinted page */
+bool
+btr_cur_search_leaf_with_hint(
+	btr_cur_leaf_hint_t*	hint,
+	dict_index_t*		index,
+	const dtuple_t*		tuple,
+	ulint			latch_mode,
+	btr_cur_t*		cursor,
+	const char*		file,
+	ulint			line,
+	mtr_t*			mtr);
+
+/** Remembers the leaf page a cursor was just positioned on, so that the
+next search of the same batch can try btr_cur_search_leaf_with_hint().
+@param[out]	hint	hint to update
+@param[in]	cursor	tree cursor on the latched leaf page */
+void
+btr_cur_leaf_hint_store(
+	btr_cur_leaf_hint_t*	hint,
+	const btr_cur_t*	cursor);
+
 /** Searches an index tree and positions a tree cursor on a given level.
 This function will avoid placing latches the travesal path and so
 should be used only for cases where-in latching is not needed.
@@ -897,6 +933,19 @@ enum btr_cur_method {
 	BTR_CUR_DELETE_REF	/*!< row_purge_poss_sec() failed */
 };
 
+/** Leaf page position kept across consecutive searches of a clustered
+index, such as the rows of a multi-row insert or the clustered index
+lookups of a secondary index scan. Consecutive searches often land on
+the same leaf page; remembering the page lets them skip the B-tree
+descent. The hint is validated with the block modify clock, in the same
+way as a stored btr_pcur_t position. */
+struct btr_cur_leaf_hint_t {
+	/** leaf page of the previous search */
+	buf::Block_hint	block;
+	/** block->modify_clock when the hint was stored */
+	ib_uint64_t	modify_clock;
+};
+
 /** The tree cursor: the definition appears here only for the compiler
 to know struct size! */
 struct btr_cur_t {
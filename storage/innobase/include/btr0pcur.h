@@ -126,6 +126,29 @@ btr_pcur_open_low(
 	mtr_t*		mtr);	/*!< in: mtr */
 #define btr_pcur_open(i,t,md,l,c,m)				\
 	btr_pcur_open_low(i,0,t,md,l,c,__FILE__,__LINE__,m)
+/** Initializes and opens a persistent cursor for an insert into the leaf
+level of a clustered index with BTR_MODIFY_LEAF and PAGE_CUR_LE. The leaf
+page remembered in the insert hint is tried first; the tree is searched
+from the root only if the tuple does not belong on that page.
+@param[in]	index	clustered index
+@param[in]	tuple	entry to be inserted
+@param[in,out]	hint	leaf page of the previous insert of the batch
+@param[out]	cursor	persistent cursor
+@param[in]	file	file name
+@param[in]	line	line where called
+@param[in,out]	mtr	mini-transaction */
+UNIV_INLINE
+void
+btr_pcur_open_with_ins_hint_func(
+	dict_index_t*		index,
+	const dtuple_t*		tuple,
+	btr_cur_leaf_hint_t*	hint,
+	btr_pcur_t*		cursor,
+	const char*		file,
+	ulint			line,
+	mtr_t*			mtr);
+#define btr_pcur_open_with_ins_hint(i,t,h,c,m)				\
+	btr_pcur_open_with_ins_hint_func(i,t,h,c,__FILE__,__LINE__,m)
 /**************************************************************//**
 Opens an persistent cursor to an index tree without initializing the
 cursor. */
@@ -45,6 +45,8 @@ Created 2/17/1996 Heikki Tuuri
 struct btr_pcur_t;
 /** B-tree cursor */
 struct btr_cur_t;
+/** Leaf page hint for consecutive inserts */
+struct btr_cur_leaf_hint_t;
 /** B-tree search information for the adaptive hash index */
 struct btr_search_t;
 
@@ -2231,6 +2231,9 @@ struct buf_pool_t{
 					on this value; 0 if LRU_old == NULL;
 					NOTE: LRU_old_len must be adjusted
 					whenever LRU_old shrinks or grows! */
+	ulint		LRU_temp_len;	/*!< number of pages of the
+					temporary tablespace in the LRU
+					list; see buf_page_peek_if_too_old() */
 
 	UT_LIST_BASE_NODE_T(buf_block_t) unzip_LRU;
 					/*!< base node of the
@@ -1141,7 +1141,9 @@ ulint
 dict_make_room_in_cache(
 /*====================*/
 	ulint		max_tables,	/*!< in: max tables allowed in cache */
-	ulint		pct_check);	/*!< in: max percent to check */
+	ulint		n_check,	/*!< in: max number of tables to
+					check */
+	ulint*		n_checked);	/*!< out: number of tables checked */
 
 #define BIG_ROW_SIZE	1024
 
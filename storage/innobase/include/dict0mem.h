@@ -732,7 +732,8 @@ desired failure rate is reached. A "round" is a fixed number of
 compression operations.
 After each round, the compression failure rate for that round is
 computed. If the failure rate is too high, then padding is incremented
-by a fixed value, otherwise it's left intact.
+by a fixed value for each multiple of the desired failure rate that was
+observed, otherwise it's left intact.
 If the compression failure is lower than the desired rate for a fixed
 number of consecutive rounds, then the padding is decreased by a fixed
 value. This is done to prevent overshooting the padding value,
@@ -747,6 +748,10 @@ and to accommodate the possible change in data compressibility. */
 /** Amount by which padding is increased. */
 #define ZIP_PAD_INCR				(128)
 
+/** Maximum number of ZIP_PAD_INCR steps by which padding is increased
+after a single round */
+#define ZIP_PAD_MAX_INCR_STEPS			(8)
+
 /** Percentage of compression failures that are allowed in a single
 round */
 extern ulong	zip_failure_threshold_pct;
@@ -61,7 +61,10 @@ then it will be removed from the pool and skipped. */
 void
 dict_stats_recalc_pool_add(
 /*=======================*/
-	const dict_table_t*	table);	/*!< in: table to add */
+	const dict_table_t*	table,	/*!< in: table to add */
+	bool			schedule_wake = true);
+					/*!< in: whether to wake up the
+					stats threads */
 
 /*****************************************************************//**
 Delete a given table from the auto recalc pool.
@@ -138,7 +141,7 @@ dict_stats_disabled_debug_update(
 /*****************************************************************//**
 This is the thread for background stats gathering. It pops tables, from
 the auto recalc list and proceeds them, eventually recalculating their
-statistics.
+statistics. innodb_stats_threads of these threads share the list.
 @return this function does not return, it calls os_thread_exit() */
 extern "C"
 os_thread_ret_t
@@ -147,7 +150,7 @@ DECLARE_THREAD(dict_stats_thread)(
 	void*	arg);	/*!< in: a dummy parameter
 			required by os_thread_create */
 
-/** Shutdown the dict stats thread. */
+/** Shutdown the dict stats threads. */
 void
 dict_stats_shutdown();
 
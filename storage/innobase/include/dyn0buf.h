@@ -184,6 +184,9 @@ public:
 
 	enum { MAX_DATA_SIZE = block_t::MAX_DATA_SIZE};
 
+	/** Number of blocks that the heap has room for when it is created */
+	enum { HEAP_N_BLOCKS = 8 };
+
 	/** Default constructor */
 	dyn_buf_t()
 		:
@@ -283,11 +286,16 @@ public:
 	void push(const byte* ptr, ib_uint32_t len)
 	{
 		while (len > 0) {
-			ib_uint32_t	n_copied;
+			/* Fill up the last block before adding a new one,
+			long strings such as BLOB pages would otherwise
+			leave most of it unused. */
+			ib_uint32_t	n_copied = MAX_DATA_SIZE - back()->m_used;
 
-			if (len >= MAX_DATA_SIZE) {
+			if (n_copied == 0) {
 				n_copied = MAX_DATA_SIZE;
-			} else {
+			}
+
+			if (n_copied > len) {
 				n_copied = len;
 			}
 
@@ -465,7 +473,11 @@ private:
 		block_t*	block;
 
 		if (m_heap == NULL) {
-			m_heap = mem_heap_create(sizeof(*block));
+			/* A buffer that outgrows m_first_block is usually a
+			large one (page splits, BLOB writes), make room for
+			several blocks at once instead of growing the heap
+			one block at a time. */
+			m_heap = mem_heap_create(sizeof(*block) * HEAP_N_BLOCKS);
 		}
 
 		block = reinterpret_cast<block_t*>(
@@ -171,6 +171,14 @@ struct fil_space_t {
 				/*!< this is set to true when we prepare to
 				truncate a single-table tablespace and its
 				.ibd file */
+	bool		deferred;
+				/*!< true if the space was registered by
+				fil_ibd_open_deferred() and its data file
+				has not been checked against the data
+				dictionary yet. A mismatch found when the
+				file is opened is then reported as a
+				missing file instead of aborting.
+				Protected by fil_system->mutex. */
 #ifdef UNIV_DEBUG
 	ulint		redo_skipped_count;
 				/*!< reference count for operations who want
@@ -227,6 +235,9 @@ struct fil_space_t {
 	/** Compression algorithm */
 	Compression::Type	compression_type;
 
+	/** Transparent page compression statistics */
+	Compression_stats	compression_stats;
+
 	/** Encryption algorithm */
 	Encryption::Type	encryption_type;
 
@@ -773,6 +784,14 @@ if we need to read from the insert buffer or to write to the log. */
 void
 fil_open_log_and_system_tablespace_files(void);
 /*==========================================*/
+/** Close least recently used data files in the background until the
+number of open files drops below the low water mark of innodb_open_files.
+@param[in]	n_max	maximum number of files to close
+@return number of files closed */
+ulint
+fil_close_lru_files(
+	ulint	n_max);
+
 /*******************************************************************//**
 Closes all open files. There must not be any pending i/o's or not flushed
 modifications in the files. */
@@ -1110,6 +1129,35 @@ fil_ibd_open(
 	const char*	path_in)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Register a file-per-table tablespace in the tablespace memory cache
+without opening its data file. The file is opened and validated by
+fil_space_open_deferred() when the table is loaded, or on the first
+access to the tablespace.
+@param[in]	id		tablespace ID
+@param[in]	flags		tablespace flags
+@param[in]	space_name	tablespace name in databasename/tablename
+format
+@param[in]	path		filepath from the data dictionary
+@return DB_SUCCESS or error code */
+dberr_t
+fil_ibd_open_deferred(
+	ulint		id,
+	ulint		flags,
+	const char*	space_name,
+	const char*	path)
+	MY_ATTRIBUTE((warn_unused_result));
+
+/** Open the data file of a tablespace that was registered by
+fil_ibd_open_deferred() and check it against the data dictionary,
+unless that has already been done.
+@param[in]	id	tablespace ID
+@return false if the data file is missing or does not belong to
+the tablespace */
+bool
+fil_space_open_deferred(
+	ulint	id)
+	MY_ATTRIBUTE((warn_unused_result));
+
 enum fil_load_status {
 	/** The tablespace file(s) were found and valid. */
 	FIL_LOAD_OK,
@@ -1418,6 +1466,18 @@ struct PageCallback {
 		os_offset_t	offset,
 		buf_block_t*	block) UNIV_NOTHROW = 0;
 
+	/** Check if a range of pages is unused, so that it need not be
+	read or converted.
+	@param[in]	page_no		first page of the range
+	@param[in]	n_pages		number of pages in the range
+	@return true if none of the pages is in use */
+	virtual bool is_free_range(
+		ulint	page_no,
+		ulint	n_pages) const UNIV_NOTHROW
+	{
+		return(false);
+	}
+
 	/** Set the name of the physical file and the file handle that is used
 	to open it for the file that is being iterated over.
 	@param filename then physical name of the tablespace file.
@@ -1578,6 +1638,13 @@ fil_get_compression(
 	ulint		space_id)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Print the transparent page compression statistics of the tablespaces
+that have had pages written with compression enabled.
+@param[in,out]	file	file where to print */
+void
+fil_print_compression_stats(
+	FILE*		file);
+
 /** Set the encryption type for the tablespace
 @param[in] space		Space ID of tablespace for which to set
 @param[in] algorithm		Encryption algorithm
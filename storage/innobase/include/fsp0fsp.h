@@ -111,6 +111,9 @@ descriptor page, but used only in the first. */
 #define	FSP_FREE_ADD		4	/* this many free extents are added
 					to the free list from above
 					FSP_FREE_LIMIT at a time */
+#define	FSP_FREE_ADD_MAX	32	/* in big tablespaces, up to 1/16 of
+					the size but at most this many
+					extents are added at a time */
 /* @} */
 
 #ifndef UNIV_INNOCHECKSUM
@@ -192,6 +195,10 @@ typedef	byte	fseg_inode_t;
 					list of the extent: at most
 					FSEG_FREE_LIST_MAX_LEN many */
 #define	FSEG_FREE_LIST_MAX_LEN	4
+#define	FSEG_FREE_LIST_MAX_LEN_LARGE	32	/* a big segment may keep
+					up to 1/16 of its reserved size but
+					at most this many extents in its
+					free list */
 /* @} */
 
 /* @defgroup Extent Descriptor Constants (moved from fsp0fsp.c) @{ */
@@ -268,8 +275,9 @@ fsp_header_get_tablespace_size(void);
 
 /** Calculate the number of pages to extend a datafile.
 We extend single-table and general tablespaces first one extent at a time,
-but 4 at a time for bigger tablespaces. It is not enough to extend always
-by one extent, because we need to add at least one extent to FSP_FREE.
+but 4 or more at a time for bigger tablespaces, see fsp_get_n_free_add().
+It is not enough to extend always by one extent, because we need to add
+at least one extent to FSP_FREE.
 A single extent descriptor page will track many extents. And the extent
 that uses its extent descriptor page is put onto the FSP_FREE_FRAG list.
 Extents that do not use their extent descriptor page are added to FSP_FREE.
@@ -322,6 +322,44 @@ struct Compression {
 	Type		m_type;
 };
 
+/** Transparent page compression statistics of a tablespace, and the
+state used for skipping compression of pages that do not compress well.
+The counters are updated without synchronisation by the threads that
+write the pages, the values are only used as a heuristic and for
+monitoring. m_n_skip_left is decremented atomically, a lost update
+could wrap it around and disable compression for good. */
+struct Compression_stats {
+
+	/** Number of pages written compressed */
+	ulint		m_n_compressed;
+
+	/** Number of pages that did not compress below the threshold
+	and were written uncompressed */
+	ulint		m_n_failed;
+
+	/** Number of pages written without trying to compress them */
+	ulint		m_n_skipped;
+
+	/** Total size of the pages that were compressed, in bytes */
+	ulint		m_bytes_in;
+
+	/** Total size of those pages after compression, in bytes */
+	ulint		m_bytes_out;
+
+	/** Time spent compressing pages, in microseconds */
+	ulint		m_time_us;
+
+	/** Number of consecutive failed compression attempts */
+	ulint		m_n_fail_streak;
+
+	/** Number of pages still to be written uncompressed before
+	compression is sampled again */
+	volatile ulint	m_n_skip_left;
+
+	/** Number of pages to skip after the next failure streak */
+	ulint		m_skip_interval;
+};
+
 /** Encryption key length */
 static const ulint ENCRYPTION_KEY_LEN = 32;
 
@@ -587,6 +625,7 @@ public:
 		m_block_size(UNIV_SECTOR_SIZE),
 		m_type(READ),
 		m_compression(),
+		m_compression_stats(),
 		m_encryption()
 	{
 		/* No op */
@@ -600,6 +639,7 @@ public:
 		m_block_size(UNIV_SECTOR_SIZE),
 		m_type(static_cast<uint16_t>(type)),
 		m_compression(),
+		m_compression_stats(),
 		m_encryption()
 	{
 		if (is_log() || is_row_log()) {
@@ -763,6 +803,20 @@ public:
 		return(m_compression);
 	}
 
+	/** Set the tablespace compression statistics to update.
+	@param[in,out]	stats	statistics of the tablespace written to */
+	void compression_stats(Compression_stats* stats)
+	{
+		m_compression_stats = stats;
+	}
+
+	/** @return the tablespace compression statistics, or NULL */
+	Compression_stats* compression_stats() const
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		return(m_compression_stats);
+	}
+
 	/** @return true if the page should be compressed */
 	bool is_compressed() const
 		MY_ATTRIBUTE((warn_unused_result))
@@ -872,6 +926,9 @@ private:
 	/** Compression algorithm */
 	Compression		m_compression;
 
+	/** Compression statistics of the tablespace, or NULL */
+	Compression_stats*	m_compression_stats;
+
 	/** Encryption algorithm */
 	Encryption		m_encryption;
 };
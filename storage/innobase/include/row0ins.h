@@ -40,6 +40,7 @@ Created 4/20/1996 Heikki Tuuri
 #include "dict0types.h"
 #include "trx0types.h"
 #include "row0types.h"
+#include "btr0types.h"
 
 /***************************************************************//**
 Checks if foreign key constraint fails for an index entry. Sets shared locks
@@ -102,9 +103,12 @@ row_ins_clust_index_entry_low(
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
 	que_thr_t*	thr,	/*!< in: query thread or NULL */
-	bool		dup_chk_only)
+	bool		dup_chk_only,
 				/*!< in: if true, just do duplicate check
 				and return. don't execute actual insert. */
+	btr_cur_leaf_hint_t*	hint = NULL)
+				/*!< in/out: leaf page of the previous
+				insert of a multi-row batch, or NULL */
 	MY_ATTRIBUTE((warn_unused_result));
 
 /***************************************************************//**
@@ -183,9 +187,12 @@ row_ins_clust_index_entry(
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr,	/*!< in: query thread */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
-	bool		dup_chk_only)
+	bool		dup_chk_only,
 				/*!< in: if true, just do duplicate check
 				and return. don't execute actual insert. */
+	btr_cur_leaf_hint_t*	hint = NULL)
+				/*!< in/out: leaf page of the previous
+				insert of a multi-row batch, or NULL */
 	MY_ATTRIBUTE((warn_unused_result));
 /***************************************************************//**
 Inserts an entry into a secondary index. Tries first optimistic,
@@ -234,6 +241,10 @@ struct ins_node_t{
 	trx_id_t	trx_id;	/*!< trx id or the last trx which executed the
 				node 执行插入操作的当前事务id*/
 	byte*		trx_id_buf;/* buffer for the trx id sys field in row 对应的就是行里面的trx_id隐藏字段*/
+	btr_cur_leaf_hint_t*	clust_hint;
+				/*!< NULL, or the clustered index leaf
+				page of the previous row when the rows
+				are inserted as part of a multi-row batch */
 	mem_heap_t*	entry_sys_heap;
 				/* memory heap used as auxiliary storage; 用来辅助存储的，比如上面提到的每个entry对象都会存在这里，以及其他信息，上面很多属性都是指针，对应的真正内容都存在了这里
 				entry_list and sys fields are stored here;
@@ -60,6 +60,15 @@ row_mysql_prebuilt_free_blob_heap(
 /*==============================*/
 	row_prebuilt_t*	prebuilt);	/*!< in: prebuilt struct of a
 					ha_innobase:: table handle */
+
+/** Free the fetch cache in prebuilt. Any rows still cached are
+discarded, so when a scan is in progress the caller must only do this
+between batches, when n_fetch_cached is 0.
+@param[in,out]	prebuilt	prebuilt struct of a ha_innobase:: table
+handle */
+void
+row_mysql_prebuilt_free_fetch_cache(
+	row_prebuilt_t*	prebuilt);
 /*******************************************************************//**
 Stores a >= 5.0.3 format true VARCHAR length to dest, in the MySQL row
 format.
@@ -667,7 +676,14 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Number of rows cached in the first batch after the cursor has been
+positioned. Later batches of the same scan cache as many rows as have
+been fetched so far, up to MYSQL_FETCH_CACHE_MAX_SIZE rows and
+MYSQL_FETCH_CACHE_MAX_BYTES bytes, so that long range scans latch each
+page only about once. */
 #define MYSQL_FETCH_CACHE_SIZE		8
+#define MYSQL_FETCH_CACHE_MAX_SIZE	128
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(64 * 1024)
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -753,6 +769,12 @@ struct row_prebuilt_t {
 	ins_node_t*	ins_node;	/*!< Innobase SQL insert node
 					used to perform inserts
 					to the table */
+	btr_cur_leaf_hint_t
+			ins_hint;	/*!< clustered index leaf page of the
+					previous row of a multi-row insert */
+	bool		ins_batch;	/*!< true between start_bulk_insert()
+					and end_bulk_insert(); each row is
+					then first tried on ins_hint */
 	byte*		ins_upd_rec_buff;/*!< buffer for storing data converted
 					to the Innobase format from the MySQL
 					format */
@@ -782,6 +804,11 @@ struct row_prebuilt_t {
 					and updates */
 	btr_pcur_t*	clust_pcur;	/*!< persistent cursor used in
 					some selects and updates */
+	btr_cur_leaf_hint_t
+			clust_hint;	/*!< clustered index leaf page of the
+					previous clustered index lookup of a
+					secondary index scan; the next lookup
+					is first tried on this page */
 	que_fork_t*	sel_graph;	/*!< dummy query graph used in
 					selects */
 	dtuple_t*	search_tuple;	/*!< prebuilt dtuple used in selects */
@@ -850,7 +877,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte**		fetch_cache;
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -860,6 +887,10 @@ struct row_prebuilt_t {
 					allocated mem buf start, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_size;/*!< number of rows fetch_cache
+					has room for, 0 if not allocated */
+	ulint		fetch_cache_limit;/*!< number of rows to cache in
+					the current batch */
 	ibool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
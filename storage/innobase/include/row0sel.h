@@ -153,6 +153,23 @@ row_sel_convert_mysql_key_to_innobase(
 	ulint		key_len,	/*!< in: MySQL key value length */
 	trx_t*		trx);		/*!< in: transaction */
 
+/** Reads ahead the clustered index leaf pages of rows that are about to be
+fetched by their row references in the given order.
+@param[in]	prebuilt	prebuilt struct in the handle
+@param[in]	refs		first row reference, in the format of
+				handler::ref
+@param[in]	n_refs		number of row references
+@param[in]	ref_len		length of a row reference
+@param[in]	ref_step	distance in bytes between two consecutive
+				row references */
+void
+row_sel_prefetch_clust_leaves_for_mysql(
+	row_prebuilt_t*	prebuilt,
+	const byte*	refs,
+	ulint		n_refs,
+	ulint		ref_len,
+	ulint		ref_step);
+
 
 /** Searches for rows in the database. This is used in the interface to
 MySQL. This function opens a cursor, and also implements fetch next
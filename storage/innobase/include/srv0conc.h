@@ -99,4 +99,12 @@ ulint
 srv_conc_get_active_threads(void);
 /*==============================*/
 
+/** Initialize the concurrency manager. */
+void
+srv_conc_init();
+
+/** Free the concurrency manager. */
+void
+srv_conc_free();
+
 #endif /* srv_conc_h */
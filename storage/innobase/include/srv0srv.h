@@ -132,6 +132,13 @@ struct srv_stats_t {
 	/** Number of threads currently waiting on database locks */
 	lint_ctr_1_t		n_lock_wait_current_count;
 
+	/** Time spent waiting to enter InnoDB when
+	innodb_thread_concurrency is exceeded, in microseconds */
+	int64_ctr_1_t		n_conc_wait_time;
+
+	/** Number of waits to enter InnoDB */
+	ulint_ctr_1_t		n_conc_wait_count;
+
 	/** Number of rows read. */
 	ulint_ctr_64_t		n_rows_read;
 
@@ -143,6 +150,27 @@ struct srv_stats_t {
 
 	/** Number of rows inserted */
 	ulint_ctr_64_t		n_rows_inserted;
+
+	/** Number of pages written with transparent page compression */
+	ulint_ctr_64_t		page_compression_compressed;
+
+	/** Number of pages written uncompressed because they did not
+	compress enough */
+	ulint_ctr_64_t		page_compression_failed;
+
+	/** Number of pages written uncompressed without trying to
+	compress them */
+	ulint_ctr_64_t		page_compression_skipped;
+
+	/** Bytes saved by transparent page compression */
+	ulint_ctr_64_t		page_compression_saved;
+
+	/** Time spent in transparent page compression, in microseconds */
+	ulint_ctr_64_t		page_compression_time;
+
+	/** Time spent applying buffered changes to pages that were read,
+	in microseconds */
+	ulint_ctr_64_t		ibuf_merge_time;
 };
 
 extern const char*	srv_main_thread_op_info;
@@ -211,9 +239,11 @@ extern my_bool	high_level_read_only;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 extern my_bool	srv_file_per_table;
-/** Sleep delay for threads waiting to enter InnoDB. In micro-seconds. */
+/** Interval at which a thread waiting to enter InnoDB re-checks
+innodb_thread_concurrency. In micro-seconds. */
 extern	ulong	srv_thread_sleep_delay;
-/** Maximum sleep delay (in micro-seconds), value of 0 disables it.*/
+/** Upper limit of srv_thread_sleep_delay (in micro-seconds), value of 0
+disables it. It is no longer adjusted adaptively. */
 extern	ulong	srv_adaptive_max_sleep_delay;
 
 /** The file format to use on new *.ibd files. */
@@ -237,6 +267,13 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+
+/** Whether to look for the data files of file-per-table tablespaces
+at startup */
+extern my_bool	srv_validate_tablespace_paths;
+
+/** Minimum saving in percent for writing a page compressed */
+extern ulong	srv_page_compression_min_saving_pct;
 #endif /* !UNIV_HOTBACKUP */
 
 /** Server undo tablespaces directory, can be absolute path. */
@@ -332,6 +369,8 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** Seconds between two periodic BP dumps, 0 if disabled */
+extern ulong	srv_buf_dump_interval;
 /** Lock table size in bytes */
 extern ulint	srv_lock_table_size;
 
@@ -343,6 +382,10 @@ extern ulint	srv_n_write_io_threads;
 
 extern uint	srv_change_buffer_max_size;
 
+/** Percentage of innodb_io_capacity used for background change buffer
+merges while the server is active */
+extern ulong	srv_change_buffer_merge_pct;
+
 /* Number of IO operations per second the server can do */
 extern ulong    srv_io_capacity;
 
@@ -420,6 +463,9 @@ extern bool	srv_buf_resize_thread_active;
 /* TRUE during the lifetime of the stats thread */
 extern ibool	srv_dict_stats_thread_active;
 
+/** Number of background threads that recalculate persistent statistics */
+extern ulong	srv_n_stats_threads;
+
 extern ulong	srv_n_spin_wait_rounds;
 extern ulong	srv_n_free_tickets_to_enter;
 extern ulong	srv_thread_sleep_delay;
@@ -538,6 +584,10 @@ extern PSI_stage_info	srv_stage_alter_table_read_pk_internal_sort;
 
 /** Performance schema stage event for monitoring buffer pool load progress. */
 extern PSI_stage_info	srv_stage_buffer_pool_load;
+
+/** Performance schema stage event for monitoring ALTER TABLE ... IMPORT
+TABLESPACE progress fil_tablespace_iterate(). */
+extern PSI_stage_info	srv_stage_import_tablespace;
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
 #endif /* !UNIV_HOTBACKUP */
@@ -907,6 +957,9 @@ struct export_var_t{
 	ulint innodb_buffer_pool_read_ahead_evicted;/*!< srv_read_ahead evicted*/
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
+	ulint innodb_ibuf_merge_time;		/*!< srv_stats.ibuf_merge_time
+						/ 1000 */
+	ulint innodb_ibuf_merges;		/*!< ibuf->n_merges */
 	ulint innodb_log_waits;			/*!< srv_log_waits */
 	ulint innodb_log_write_requests;	/*!< srv_log_write_requests */
 	ulint innodb_log_writes;		/*!< srv_log_writes */
@@ -915,6 +968,16 @@ struct export_var_t{
 	ulint innodb_os_log_pending_writes;	/*!< srv_os_log_pending_writes */
 	ulint innodb_os_log_pending_fsyncs;	/*!< fil_n_pending_log_flushes */
 	ulint innodb_page_size;			/*!< UNIV_PAGE_SIZE */
+	ulint innodb_page_compression_compressed;/*!< srv_stats.
+						page_compression_compressed */
+	ulint innodb_page_compression_failed;	/*!< srv_stats.
+						page_compression_failed */
+	ulint innodb_page_compression_skipped;	/*!< srv_stats.
+						page_compression_skipped */
+	ulint innodb_page_compression_saved;	/*!< srv_stats.
+						page_compression_saved */
+	ulint innodb_page_compression_time;	/*!< srv_stats.
+						page_compression_time / 1000 */
 	ulint innodb_pages_created;		/*!< buf_pool->stat.n_pages_created */
 	ulint innodb_pages_read;		/*!< buf_pool->stat.n_pages_read */
 	ulint innodb_pages_written;		/*!< buf_pool->stat.n_pages_written */
@@ -931,6 +994,10 @@ struct export_var_t{
 	ulint innodb_rows_inserted;		/*!< srv_n_rows_inserted */
 	ulint innodb_rows_updated;		/*!< srv_n_rows_updated */
 	ulint innodb_rows_deleted;		/*!< srv_n_rows_deleted */
+	ulint innodb_thread_concurrency_waits;	/*!< srv_stats.n_conc_wait_count */
+	int64_t innodb_thread_concurrency_wait_time;
+						/*!< srv_stats.n_conc_wait_time
+						/ 1000 */
 	ulint innodb_num_open_files;		/*!< fil_n_file_opened */
 	ulint innodb_truncated_status_writes;	/*!< srv_truncated_status_writes */
 	ulint innodb_available_undo_logs;       /*!< srv_available_undo_logs */
@@ -1096,6 +1096,12 @@ struct trx_t {
 					declared_to_... is TRUE; when we come
 					to srv_conc_innodb_enter, if the value
 					here is > 0, we decrement this by 1 */
+	os_event_t	conc_wait_event;
+					/*!< event on which the thread waits
+					in srv_conc_enter_innodb() for a place
+					inside InnoDB; created on the first
+					such wait and kept for the lifetime
+					of the trx object */
 	ib_uint32_t	dict_operation_lock_mode;
 					/*!< 0, RW_S_LATCH, or RW_X_LATCH:
 					the latch mode trx currently holds
@@ -423,11 +423,26 @@ public:
 
 #ifdef LINUX_NATIVE_AIO
 	/** Dispatch an AIO request to the kernel.
-	@param[in,out]	slot	an already reserved slot
+	@param[in,out]	slot		an already reserved slot
+	@param[in]	should_buffer	true if the request may be buffered
+					and submitted with the rest of a batch
+					by linux_dispatch_pending()
 	@return true on success. */
-	bool linux_dispatch(Slot* slot)
+	bool linux_dispatch(Slot* slot, bool should_buffer)
 		MY_ATTRIBUTE((warn_unused_result));
 
+	/** Submit the buffered requests of a segment to the kernel with
+	a single io_submit() call. The caller must own the mutex.
+	@param[in]	segment	local segment in the array */
+	void linux_submit_pending(ulint segment);
+
+	/** Submit the buffered requests of every segment of the array.
+	The caller must own the mutex. */
+	void linux_submit_all_pending();
+
+	/** Submit all the buffered read requests to the kernel. */
+	static void linux_dispatch_pending();
+
 	/** Accessor for an AIO event
 	@param[in]	index	Index into the array
 	@return the event at the index */
@@ -705,6 +720,17 @@ private:
 	event for each possible pending IO. The size of the array
 	is equal to m_slots.size(). */
 	IOEvents		m_events;
+
+	typedef std::vector<iocb*> IOCBs;
+
+	/** Requests that have been reserved but not submitted to the
+	kernel yet, slots_per_segment() entries for each segment.
+	Protected by m_mutex. */
+	IOCBs			m_pending;
+
+	/** Number of buffered requests in m_pending for each segment.
+	Protected by m_mutex. */
+	std::vector<ulint>	m_count;
 #endif /* LINUX_NATIV_AIO */
 
 	/** The aio arrays for non-ibuf i/o and ibuf i/o, as well as
@@ -2065,6 +2091,107 @@ os_file_create_subdirs_if_needed(
 	return(success ? DB_SUCCESS : DB_ERROR);
 }
 
+/** Number of consecutive pages of a tablespace that must fail to compress
+before compression of the tablespace is skipped for a while. */
+static const ulint	OS_COMPRESS_FAIL_STREAK = 16;
+
+/** Minimum and maximum number of pages for which compression is skipped.
+The interval is doubled every time sampling finds that the pages still do
+not compress. */
+static const ulint	OS_COMPRESS_SKIP_MIN = 64;
+static const ulint	OS_COMPRESS_SKIP_MAX = 4096;
+
+/** Account for a page compression attempt and decide whether the following
+pages of the tablespace should be written without trying to compress them.
+@param[in,out]	stats		tablespace statistics, or NULL
+@param[in]	compressed	true if the page is written compressed
+@param[in]	len		length of the page
+@param[in]	compressed_len	length written to disk
+@param[in]	time_us		time spent compressing, in microseconds
+@param[in]	adaptive	true if compression may be skipped */
+static
+void
+os_file_compress_page_stats(
+	Compression_stats*	stats,
+	bool			compressed,
+	ulint			len,
+	ulint			compressed_len,
+	ulint			time_us,
+	bool			adaptive)
+{
+	srv_stats.page_compression_time.add(time_us);
+
+	if (compressed) {
+		srv_stats.page_compression_compressed.inc();
+		srv_stats.page_compression_saved.add(len - compressed_len);
+	} else {
+		srv_stats.page_compression_failed.inc();
+	}
+
+	if (stats == NULL) {
+		return;
+	}
+
+	stats->m_bytes_in += len;
+	stats->m_bytes_out += compressed_len;
+	stats->m_time_us += time_us;
+
+	if (compressed) {
+
+		++stats->m_n_compressed;
+
+		stats->m_n_fail_streak = 0;
+		stats->m_skip_interval = 0;
+
+		return;
+	}
+
+	++stats->m_n_failed;
+
+	if (!adaptive) {
+
+		stats->m_n_fail_streak = 0;
+
+	} else if (++stats->m_n_fail_streak >= OS_COMPRESS_FAIL_STREAK) {
+
+		stats->m_skip_interval = stats->m_skip_interval == 0
+			? OS_COMPRESS_SKIP_MIN
+			: ut_min(stats->m_skip_interval * 2,
+				 OS_COMPRESS_SKIP_MAX);
+
+		stats->m_n_skip_left = stats->m_skip_interval;
+
+		/* A single failure of the next sampled page is enough
+		to skip again. */
+		stats->m_n_fail_streak = OS_COMPRESS_FAIL_STREAK - 1;
+	}
+}
+
+/** Take a page from the number of pages of a tablespace that are to be
+written without trying to compress them.
+@param[in,out]	stats	tablespace statistics
+@return true if the page is to be written uncompressed */
+static
+bool
+os_file_compress_page_skip(
+	Compression_stats*	stats)
+{
+	for (;;) {
+		ulint	n_skip_left = stats->m_n_skip_left;
+
+		if (n_skip_left == 0) {
+			return(false);
+		}
+
+		if (os_compare_and_swap_ulint(
+			    &stats->m_n_skip_left,
+			    n_skip_left, n_skip_left - 1)) {
+
+			return(true);
+		}
+	}
+}
+
 /** Allocate the buffer for IO on a transparently compressed table.
 @param[in]	type		IO flags
 @param[out]	buf		buffer to read or write
@@ -2083,6 +2210,21 @@ os_file_compress_page(
 	ut_ad(type.is_write());
 	ut_ad(type.is_compressed());
 
+	Compression_stats*	stats = type.compression_stats();
+	ulint			min_saving = srv_page_compression_min_saving_pct;
+
+	/* Recent pages of the tablespace did not compress well, write
+	the page as is without spending CPU on it. */
+	if (stats != NULL && min_saving > 0
+	    && os_file_compress_page_skip(stats)) {
+
+		++stats->m_n_skipped;
+
+		srv_stats.page_compression_skipped.inc();
+
+		return(NULL);
+	}
+
 	ulint	n_alloc = *n * 2;
 
 	ut_a(n_alloc <= UNIV_PAGE_SIZE_MAX * 2);
@@ -2113,6 +2255,8 @@ os_file_compress_page(
 
 	byte*	buf_ptr;
 
+	ib_time_monotonic_us_t	start_us = ut_time_monotonic_us();
+
 	buf_ptr = os_file_compress_page(
 		type.compression_algorithm(),
 		type.block_size(),
@@ -2121,6 +2265,23 @@ os_file_compress_page(
 		compressed_page,
 		&compressed_len);
 
+	ulint	time_us = static_cast<ulint>(
+		ut_time_monotonic_us() - start_us);
+
+	/* Don't bother with pages that did not shrink enough, reading
+	them back would cost more than the space saved. */
+	if (buf_ptr != buf
+	    && min_saving > 0
+	    && compressed_len > *n - *n * min_saving / 100) {
+
+		buf_ptr = reinterpret_cast<byte*>(buf);
+		compressed_len = *n;
+	}
+
+	os_file_compress_page_stats(
+		stats, buf_ptr != buf, *n, compressed_len, time_us,
+		min_saving > 0);
+
 	if (buf_ptr != buf) {
 		/* Set new compressed size to uncompressed page. */
 		memcpy(reinterpret_cast<byte*>(buf) + FIL_PAGE_COMPRESS_SIZE_V1,
@@ -2579,6 +2740,15 @@ LinuxAIOHandler::collect()
 			m_array->release();
 		}
 
+		if (ret == 0 && AIO::is_read(m_array)) {
+			/* Timed out. Submit any reads that were left
+			buffered by a caller that did not invoke
+			os_aio_simulated_wake_handler_threads(). */
+			m_array->acquire();
+			m_array->linux_submit_pending(m_segment);
+			m_array->release();
+		}
+
 		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
 		    || !buf_page_cleaner_is_active
 		    || ret > 0) {
@@ -2748,7 +2918,7 @@ os_aio_linux_handler(
 @param[in,out]	slot		an already reserved slot
 @return true on success. */
 bool
-AIO::linux_dispatch(Slot* slot)
+AIO::linux_dispatch(Slot* slot, bool should_buffer)
 {
 	ut_a(slot->is_reserved);
 	ut_ad(slot->type.validate());
@@ -2762,6 +2932,32 @@ AIO::linux_dispatch(Slot* slot)
 
 	io_ctx_index = (slot->pos * m_n_segments) / m_slots.size();
 
+	if (should_buffer) {
+		ulint	n_per_seg = slots_per_segment();
+
+		acquire();
+
+		ut_ad(m_count[io_ctx_index] < n_per_seg);
+
+		m_pending[io_ctx_index * n_per_seg + m_count[io_ctx_index]]
+			= iocb;
+
+		/* Submit the batch once every slot of the segment
+		is waiting for it, and everything once no slot of the
+		array is left for the rest of the batch. */
+		if (++m_count[io_ctx_index] == n_per_seg) {
+			linux_submit_pending(io_ctx_index);
+		}
+
+		if (m_n_reserved == m_slots.size()) {
+			linux_submit_all_pending();
+		}
+
+		release();
+
+		return(true);
+	}
+
 	int	ret = io_submit(m_aio_ctx[io_ctx_index], 1, &iocb);
 
 	/* io_submit() returns number of successfully queued requests
@@ -2774,6 +2970,102 @@ AIO::linux_dispatch(Slot* slot)
 	return(ret == 1);
 }
 
+/** Submit the buffered requests of a segment to the kernel with
+a single io_submit() call. The caller must own the mutex.
+@param[in]	segment	local segment in the array */
+void
+AIO::linux_submit_pending(ulint segment)
+{
+	ut_ad(is_mutex_owned());
+
+	iocb**	iocbs = &m_pending[segment * slots_per_segment()];
+	ulint	count = m_count[segment];
+
+	m_count[segment] = 0;
+
+	while (count > 0) {
+		int	ret;
+
+		DBUG_EXECUTE_IF(
+			"ib_os_aio_submit_pending_eagain",
+			DBUG_SET("-d,ib_os_aio_submit_pending_eagain");
+			ret = -EAGAIN;
+			goto submit_failed;);
+
+		ret = io_submit(
+			m_aio_ctx[segment], static_cast<long>(count), iocbs);
+
+		/* io_submit() returns number of successfully queued
+		requests or -errno. */
+
+		if (ret > 0) {
+			/* Submit the rest. */
+			iocbs += ret;
+			count -= ret;
+			continue;
+		}
+
+#ifndef DBUG_OFF
+submit_failed:
+#endif /* !DBUG_OFF */
+		Slot*	slot = reinterpret_cast<Slot*>(iocbs[0]->data);
+
+		/* Retry the transient errors, as os_aio_func() does
+		for a request that is submitted on its own. */
+		int	err = ret < 0 ? -ret : EIO;
+
+		errno = err;
+
+		if (os_file_handle_error(slot->name, "aio read")) {
+			continue;
+		}
+
+		/* Report the requests that could not be queued as
+		failed. The I/O handler thread of the segment will
+		find them after its io_getevents() call times out. */
+		ib::error()
+			<< "io_submit() of " << count << " requests failed"
+			" with errno " << err;
+
+		for (ulint i = 0; i < count; ++i) {
+			slot = reinterpret_cast<Slot*>(iocbs[i]->data);
+
+			slot->io_already_done = true;
+			slot->n_bytes = 0;
+			slot->ret = -err;
+		}
+
+		break;
+	}
+}
+
+/** Submit the buffered requests of every segment of the array.
+The caller must own the mutex. */
+void
+AIO::linux_submit_all_pending()
+{
+	ut_ad(is_mutex_owned());
+
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		if (m_count[i] > 0) {
+			linux_submit_pending(i);
+		}
+	}
+}
+
+/** Submit all the buffered read requests to the kernel. */
+void
+AIO::linux_dispatch_pending()
+{
+	AIO*	array = s_reads;
+
+	array->acquire();
+
+	array->linux_submit_all_pending();
+
+	array->release();
+}
+
 /** Creates an io_context for native linux AIO.
 @param[in]	max_events	number of events
 @param[out]	io_ctx		io_ctx to initialize.
@@ -6312,7 +6604,9 @@ AIO::AIO(
 	m_n_reserved()
 # ifdef LINUX_NATIVE_AIO
 	,m_aio_ctx(),
-	m_events(m_slots.size())
+	m_events(m_slots.size()),
+	m_pending(m_slots.size()),
+	m_count(segments)
 # elif defined(_WIN32)
 	,m_handles()
 # endif /* LINUX_NATIVE_AIO */
@@ -6938,6 +7232,15 @@ AIO::reserve_slot(
 			break;
 		}
 
+#ifdef LINUX_NATIVE_AIO
+		/* The slots we are waiting for may be held by reads
+		that are still buffered. Submit them, otherwise nobody
+		may free a slot until the i/o-handler thread times out. */
+		if (srv_use_native_aio && is_read(this)) {
+			linux_submit_all_pending();
+		}
+#endif /* LINUX_NATIVE_AIO */
+
 		release();
 
 		if (!srv_use_native_aio) {
@@ -7173,7 +7476,10 @@ void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
-		/* We do not use simulated aio: do nothing */
+#ifdef LINUX_NATIVE_AIO
+		/* Submit the batched reads. */
+		AIO::linux_dispatch_pending();
+#endif /* LINUX_NATIVE_AIO */
 
 		return;
 	}
@@ -7497,7 +7803,12 @@ try_again:
 				file.m_file, slot->ptr, slot->len,
 				&slot->n_bytes, &slot->control);
 #elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+			/* Batch the reads of a read-ahead, the caller
+			will invoke os_aio_simulated_wake_handler_threads()
+			after posting them all. */
+			if (!array->linux_dispatch(
+				    slot,
+				    !type.is_wake() && AIO::is_read(array))) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -7515,7 +7826,7 @@ try_again:
 				file.m_file, slot->ptr, slot->len,
 				&slot->n_bytes, &slot->control);
 #elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+			if (!array->linux_dispatch(slot, false)) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -55,12 +55,12 @@ Created 2012-02-08 by Sunny Bains.
 
 #include <my_aes.h>
 
-/** The size of the buffer to use for IO. Note: os_file_read() doesn't expect
-reads to fail. If you set the buffer size to be greater than a multiple of the
-file size then it will assert. TODO: Fix this limitation of the IO functions.
+/** The size of the buffer to use for IO. fil_iterate() trims the last read
+to the end of the file, and falls back to single page IO for compressed and
+encrypted tablespaces.
 @param n page size of the tablespace.
 @retval number of pages */
-#define IO_BUFFER_SIZE(m, n)	((m) / (n))
+#define IO_BUFFER_SIZE(n)	((1024 * 1024) / (n))
 
 /** For gathering stats on records during phase I */
 struct row_stats_t {
@@ -506,6 +506,30 @@ protected:
 		return(true);
 	}
 
+	/** Check if a range of pages is marked as free in the current
+	extent descriptor page. The extent descriptor page itself is never
+	free, it must be read to find out about the following pages.
+	@param[in]	page_no		first page of the range
+	@param[in]	n_pages		number of pages in the range
+	@return true if all the pages are free */
+	virtual bool is_free_range(
+		ulint	page_no,
+		ulint	n_pages) const UNIV_NOTHROW
+	{
+		for (ulint i = page_no; i < page_no + n_pages; ++i) {
+
+			if (i == m_xdes_page_no
+			    || xdes_calc_descriptor_page(get_page_size(), i)
+			    != m_xdes_page_no
+			    || !is_free(i)) {
+
+				return(false);
+			}
+		}
+
+		return(true);
+	}
+
 protected:
 	/** Covering transaction. */
 	trx_t*			m_trx;
@@ -3722,9 +3746,7 @@ row_import_for_mysql(
 		FetchIndexRootPages	fetchIndexRootPages(table, trx);
 
 		err = fil_tablespace_iterate(
-			table, IO_BUFFER_SIZE(
-				cfg.m_page_size.physical(),
-				cfg.m_page_size.physical()),
+			table, IO_BUFFER_SIZE(cfg.m_page_size.physical()),
 			fetchIndexRootPages);
 
 		if (err == DB_SUCCESS) {
@@ -3789,9 +3811,7 @@ row_import_for_mysql(
 	/* Set the IO buffer size in pages. */
 
 	err = fil_tablespace_iterate(
-		table, IO_BUFFER_SIZE(
-			cfg.m_page_size.physical(),
-			cfg.m_page_size.physical()), converter);
+		table, IO_BUFFER_SIZE(cfg.m_page_size.physical()), converter);
 
 	DBUG_EXECUTE_IF("ib_import_reset_space_and_lsn_failure",
 			err = DB_TOO_MANY_CONCURRENT_TRXS;);
@@ -101,6 +101,8 @@ ins_node_create(
 
 	node->trx_id = 0;
 
+	node->clust_hint = NULL;
+
 	node->entry_sys_heap = mem_heap_create(128);
 
 	node->magic_n = INS_NODE_MAGIC_N;
@@ -2489,9 +2491,12 @@ row_ins_clust_index_entry_low(
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
 	que_thr_t*	thr,	/*!< in: query thread */
-	bool		dup_chk_only)
+	bool		dup_chk_only,
 				/*!< in: if true, just do duplicate check
 				and return. don't execute actual insert. */
+	btr_cur_leaf_hint_t*	hint)
+				/*!< in/out: leaf page of the previous
+				insert of a multi-row batch, or NULL */
 {
 	btr_pcur_t	pcur;
 	btr_cur_t*	cursor;
@@ -2537,7 +2542,13 @@ row_ins_clust_index_entry_low(
 	cursor sensible values */
         // 会进入到btr0pcur.ic中的btr_pcur_open_low()函数
 	// 会从索引对应的B+树的叶子节点开始找
-        btr_pcur_open(index, entry, PAGE_CUR_LE, mode, &pcur, &mtr);
+	if (hint != NULL && mode == BTR_MODIFY_LEAF) {
+		/* Consecutive rows of a batch often belong on the leaf
+		page of the previous row; try it before the descent. */
+		btr_pcur_open_with_ins_hint(index, entry, hint, &pcur, &mtr);
+	} else {
+		btr_pcur_open(index, entry, PAGE_CUR_LE, mode, &pcur, &mtr);
+	}
 	cursor = btr_pcur_get_btr_cur(&pcur);
 	cursor->thr = thr;
 
@@ -2646,6 +2657,10 @@ err_exit:
 				flags, cursor, &offsets, &offsets_heap,
 				entry, &insert_rec, &big_rec,
 				n_ext, thr, &mtr);
+
+			if (err == DB_SUCCESS && hint != NULL) {
+				btr_cur_leaf_hint_store(hint, cursor);
+			}
 		} else {
 			if (buf_LRU_buf_pool_running_out()) {
 
@@ -3288,9 +3303,12 @@ row_ins_clust_index_entry(
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr,	/*!< in: query thread */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
-	bool		dup_chk_only)
+	bool		dup_chk_only,
 				/*!< in: if true, just do duplicate check
 				and return. don't execute actual insert. */
+	btr_cur_leaf_hint_t*	hint)
+				/*!< in/out: leaf page of the previous
+				insert of a multi-row batch, or NULL */
 {
 	dberr_t	err;
 	ulint	n_uniq;
@@ -3335,7 +3353,8 @@ row_ins_clust_index_entry(
                 // 核心的插入操作，BTR_MODIFY_LEAF表示修改叶子节点，需要加X锁
 		err = row_ins_clust_index_entry_low(
 			flags, BTR_MODIFY_LEAF, index, n_uniq, entry,
-			n_ext, thr, dup_chk_only);
+			n_ext, thr, dup_chk_only,
+			dict_table_is_intrinsic(index->table) ? NULL : hint);
 	}
 
 
@@ -3462,6 +3481,9 @@ row_ins_index_entry(
 /*================*/
 	dict_index_t*	index,	/*!< in: index */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
+	btr_cur_leaf_hint_t*	clust_hint,
+				/*!< in/out: clustered index leaf page
+				of the previous row of a batch, or NULL */
 	que_thr_t*	thr)	/*!< in: query thread */
 {
 	ut_ad(thr_get_trx(thr)->id != 0);
@@ -3471,7 +3493,8 @@ row_ins_index_entry(
 			return(DB_LOCK_WAIT);});
         // 聚集索引
 	if (dict_index_is_clust(index)) {
-		return(row_ins_clust_index_entry(index, entry, thr, 0, false));
+		return(row_ins_clust_index_entry(
+			index, entry, thr, 0, false, clust_hint));
 	} else {
         // 二级索引
 		return(row_ins_sec_index_entry(index, entry, thr, false));
@@ -3622,7 +3645,8 @@ row_ins_index_entry_step(
 
 	ut_ad(dtuple_check_typed(node->entry));
         // 将索引记录插入到索引中，核心
-	err = row_ins_index_entry(node->index, node->entry, thr);
+	err = row_ins_index_entry(
+		node->index, node->entry, node->clust_hint, thr);
 
 	DEBUG_SYNC_C_IF_THD(thr_get_trx(thr)->mysql_thd,
 			    "after_row_ins_index_entry_step");
@@ -204,6 +204,11 @@ struct row_log_t {
 				or by index->lock X-latch only */
 	row_log_buf_t	head;	/*!< reader context; protected by MDL only;
 				modifiable by row_log_apply_ops() */
+	bool		punched;/*!< whether the disk space of every block
+				read by the applier was freed, so that only
+				the unapplied blocks take up disk space;
+				protected like tail, or by mutex alone in
+				row_log_block_discard() */
 	ulint		n_old_col;
 				/*!< number of non-virtual column in
 				old table */
@@ -278,6 +283,67 @@ row_log_block_free(
 	DBUG_VOID_RETURN;
 }
 
+/** Determine if writing one more block to the temporary file would make
+the online log exceed innodb_online_alter_log_max_size. While the
+applier frees the disk space of every block that it reads, only the
+blocks that have not been applied yet are counted, so that a log that is
+applied concurrently with the DML may keep growing as long as it keeps
+up. Otherwise the size of the file is limited.
+@param[in]	log	online log, protected by the index lock S or X
+			and log->mutex
+@return whether the log would grow too big */
+static
+bool
+row_log_block_too_big(
+	const row_log_t*	log)
+{
+	ut_ad(mutex_own(&log->mutex));
+	ut_ad(log->head.blocks <= log->tail.blocks);
+
+	const ulint	blocks = log->punched
+		? log->tail.blocks - log->head.blocks
+		: log->tail.blocks;
+
+	return((os_offset_t) (blocks + 1) * srv_sort_buf_size
+	       >= srv_online_max_size);
+}
+
+/** Free the disk space of a block of the temporary file that has been
+read by the applier. Each block is read exactly once. If the space
+cannot be freed, it is released when the applier has caught up with the
+writers and the file is truncated; until then the whole file counts
+against innodb_online_alter_log_max_size.
+@param[in,out]	log	online log
+@param[in]	ofs	offset of the block in the temporary file */
+static
+void
+row_log_block_discard(
+	row_log_t*	log,
+	os_offset_t	ofs)
+{
+	bool	punched = false;
+
+#ifdef POSIX_FADV_DONTNEED
+	/* Free up the file cache. */
+	posix_fadvise(log->fd, ofs, srv_sort_buf_size, POSIX_FADV_DONTNEED);
+#endif /* POSIX_FADV_DONTNEED */
+
+#ifndef _WIN32
+	/* Free up the disk space. */
+	punched = IORequest::is_punch_hole_supported()
+		&& os_file_punch_hole(log->fd, ofs, srv_sort_buf_size)
+		== DB_SUCCESS;
+#endif /* !_WIN32 */
+
+	DBUG_EXECUTE_IF("row_log_punch_hole_fail", punched = false;);
+
+	if (!punched && log->punched) {
+		mutex_enter(&log->mutex);
+		log->punched = false;
+		mutex_exit(&log->mutex);
+	}
+}
+
 /******************************************************//**
 Logs an operation to a secondary index that is (or was) being created. */
 void
@@ -369,7 +435,8 @@ row_log_online_op(
 			= (os_offset_t) log->tail.blocks
 			* srv_sort_buf_size;
 
-		if (byte_offset + srv_sort_buf_size >= srv_online_max_size) {
+		if (row_log_block_too_big(log)) {
+			log->error = DB_ONLINE_LOG_TOO_BIG;
 			goto write_failed;
 		}
 
@@ -489,7 +556,7 @@ row_log_table_close_func(
 			= (os_offset_t) log->tail.blocks
 			* srv_sort_buf_size;
 
-		if (byte_offset + srv_sort_buf_size >= srv_online_max_size) {
+		if (row_log_block_too_big(log)) {
 			goto write_failed;
 		}
 
@@ -2884,6 +2951,8 @@ corruption:
 			if (index->online_log->fd > 0
 			    && ftruncate(index->online_log->fd, 0) == -1) {
 				perror("ftruncate");
+			} else {
+				index->online_log->punched = true;
 			}
 #endif /* HAVE_FTRUNCATE */
 			index->online_log->head.blocks
@@ -2938,11 +3007,7 @@ all_done:
 			goto corruption;
 		}
 
-#ifdef POSIX_FADV_DONTNEED
-		/* Each block is read exactly once.  Free up the file cache. */
-		posix_fadvise(index->online_log->fd,
-			      ofs, srv_sort_buf_size, POSIX_FADV_DONTNEED);
-#endif /* POSIX_FADV_DONTNEED */
+		row_log_block_discard(index->online_log, ofs);
 
 		next_mrec = index->online_log->head.block;
 		next_mrec_end = next_mrec + srv_sort_buf_size;
@@ -3243,6 +3308,7 @@ row_log_allocate(
 	log->tail.block = log->head.block = NULL;
 	log->head.blocks = log->head.bytes = 0;
 	log->head.total = 0;
+	log->punched = true;
 	log->path = path;
 	log->n_old_col = index->table->n_cols;
 	log->n_old_vcol = index->table->n_v_cols;
@@ -3726,6 +3792,8 @@ corruption:
 			if (index->online_log->fd > 0
 			    && ftruncate(index->online_log->fd, 0) == -1) {
 				perror("ftruncate");
+			} else {
+				index->online_log->punched = true;
 			}
 #endif /* HAVE_FTRUNCATE */
 			index->online_log->head.blocks
@@ -3776,11 +3844,9 @@ all_done:
 			goto corruption;
 		}
 
-#ifdef POSIX_FADV_DONTNEED
-		/* Each block is read exactly once.  Free up the file cache. */
-		posix_fadvise(index->online_log->fd,
-			      ofs, srv_sort_buf_size, POSIX_FADV_DONTNEED);
-#endif /* POSIX_FADV_DONTNEED */
+		row_log_block_discard(index->online_log, ofs);
+
+		DEBUG_SYNC_C("row_log_apply_block_read");
 
 		next_mrec = index->online_log->head.block;
 		next_mrec_end = next_mrec + srv_sort_buf_size;
@@ -3938,17 +4004,7 @@ func_exit:
 		rw_lock_x_lock(dict_index_get_lock(index));
 	}
 
-	switch (error) {
-	case DB_SUCCESS:
-		break;
-	case DB_INDEX_CORRUPT:
-		if (((os_offset_t) index->online_log->tail.blocks + 1)
-		    * srv_sort_buf_size >= srv_online_max_size) {
-			/* The log file grew too big. */
-			error = DB_ONLINE_LOG_TOO_BIG;
-		}
-		/* fall through */
-	default:
+	if (error != DB_SUCCESS) {
 		/* We set the flag directly instead of invoking
 		dict_set_corrupted_index_cache_only(index) here,
 		because the index is not "public" yet. */
@@ -62,8 +62,69 @@ Completed by Sunny Bains and Marko Makela
 /* Whether to disable file system cache */
 char	srv_disable_sort_file_cache;
 
-/** Class that caches index row tuples made from a single cluster
-index page scan, and then insert into corresponding index tree */
+/** Compute the position of a point on a Hilbert curve that fills a
+65536 x 65536 grid.
+@param[in]	x	x coordinate, < 65536
+@param[in]	y	y coordinate, < 65536
+@return distance from the start of the curve */
+static
+ib_uint64_t
+row_merge_hilbert_key(
+	ulint	x,
+	ulint	y)
+{
+	static const ulint	n = 1 << 16;
+	ib_uint64_t		d = 0;
+
+	for (ulint s = n / 2; s > 0; s /= 2) {
+		const ulint	rx = (x & s) != 0;
+		const ulint	ry = (y & s) != 0;
+
+		d += ib_uint64_t(s) * s * ((3 * rx) ^ ry);
+
+		/* Rotate the quadrant */
+		if (ry == 0) {
+			if (rx == 1) {
+				x = n - 1 - x;
+				y = n - 1 - y;
+			}
+
+			std::swap(x, y);
+		}
+	}
+
+	return(d);
+}
+
+/** Map a coordinate of an MBR center to the Hilbert curve grid.
+@param[in]	v	coordinate
+@param[in]	min_v	smallest coordinate of the batch
+@param[in]	scale	grid cells per unit
+@return grid coordinate, < 65536; 0 if v is not a finite number */
+static
+ulint
+row_merge_hilbert_coord(
+	double	v,
+	double	min_v,
+	double	scale)
+{
+	const double	c = (v - min_v) * scale;
+
+	/* The comparisons are false for NaN, which converting to an
+	integer would make undefined. */
+	if (!(c >= 0)) {
+		return(0);
+	} else if (!(c <= 65535)) {
+		return(65535);
+	}
+
+	return(ulint(c));
+}
+
+/** Class that caches index row tuples made from a cluster index scan,
+and then insert into corresponding index tree. The tuples are inserted
+in the order of the Hilbert curve through the centers of their MBRs, so
+that consecutive inserts go to the same or neighbouring R-tree pages. */
 class index_tuple_info_t {
 public:
 	/** constructor
@@ -105,6 +166,12 @@ public:
 
 		ut_ad(dtuple);
 
+		/* The fields point to the clustered index page, copy them
+		so that the tuple can be cached past the page latch. */
+		for (ulint i = 0; i < dtuple_get_n_fields(dtuple); i++) {
+			dfield_dup(dtuple_get_nth_field(dtuple, i), m_heap);
+		}
+
 		m_dtuple_vec->push_back(dtuple);
 	}
 
@@ -141,6 +208,8 @@ public:
 			log_sys->check_flush_or_checkpoint = true;
 		);
 
+		sort_by_hilbert_key();
+
 		for (idx_tuple_vec::iterator it = m_dtuple_vec->begin();
 		     it != m_dtuple_vec->end();
 		     ++it) {
@@ -249,8 +318,86 @@ public:
 	}
 
 private:
-	/** Cache index rows made from a cluster index scan. Usually
-	for rows on single cluster index page */
+	/** Tuple and its position on the Hilbert curve */
+	typedef std::pair<ib_uint64_t, dtuple_t*>	hilbert_tuple_t;
+
+	typedef std::vector<hilbert_tuple_t, ut_allocator<hilbert_tuple_t> >
+		hilbert_tuple_vec;
+
+	/** Sort the cached tuples by the Hilbert key of the center of
+	their MBR, on a grid spanning the MBRs of all the cached tuples. */
+	void sort_by_hilbert_key()
+	{
+		const ulint	n = m_dtuple_vec->size();
+
+		if (n < 2) {
+			return;
+		}
+
+		hilbert_tuple_vec	keyed;
+		double			min_x = DBL_MAX;
+		double			min_y = DBL_MAX;
+		double			max_x = -DBL_MAX;
+		double			max_y = -DBL_MAX;
+
+		keyed.reserve(n);
+
+		for (ulint i = 0; i < n; i++) {
+			rtr_mbr_t	mbr;
+
+			rtr_get_mbr_from_tuple((*m_dtuple_vec)[i], &mbr);
+
+			/* Halve first, so that the sum cannot overflow */
+			const double	x = mbr.xmin / 2 + mbr.xmax / 2;
+			const double	y = mbr.ymin / 2 + mbr.ymax / 2;
+
+			min_x = std::min(min_x, x);
+			min_y = std::min(min_y, y);
+			max_x = std::max(max_x, x);
+			max_y = std::max(max_y, y);
+		}
+
+		const double	scale_x = max_x > min_x
+			? 65535 / (max_x - min_x) : 0;
+		const double	scale_y = max_y > min_y
+			? 65535 / (max_y - min_y) : 0;
+
+		for (ulint i = 0; i < n; i++) {
+			dtuple_t*	dtuple = (*m_dtuple_vec)[i];
+			rtr_mbr_t	mbr;
+
+			rtr_get_mbr_from_tuple(dtuple, &mbr);
+
+			const double	x = mbr.xmin / 2 + mbr.xmax / 2;
+			const double	y = mbr.ymin / 2 + mbr.ymax / 2;
+
+			keyed.push_back(hilbert_tuple_t(
+				row_merge_hilbert_key(
+					row_merge_hilbert_coord(
+						x, min_x, scale_x),
+					row_merge_hilbert_coord(
+						y, min_y, scale_y)),
+				dtuple));
+		}
+
+		std::stable_sort(keyed.begin(), keyed.end(),
+				 hilbert_key_less);
+
+		for (ulint i = 0; i < n; i++) {
+			(*m_dtuple_vec)[i] = keyed[i].second;
+		}
+	}
+
+	/** Compare the Hilbert keys of two tuples */
+	static bool hilbert_key_less(
+		const hilbert_tuple_t&	a,
+		const hilbert_tuple_t&	b)
+	{
+		return(a.first < b.first);
+	}
+
+	/** Cache index rows made from a cluster index scan, up to
+	innodb_sort_buffer_size bytes */
 	typedef std::vector<dtuple_t*, ut_allocator<dtuple_t*> >
 		idx_tuple_vec;
 
@@ -1549,6 +1696,8 @@ row_mtuple_cmp(
 @param[in,out]	pcur		cluster index cursor
 @param[in,out]	mtr		mini transaction
 @param[in,out]	mtr_committed	whether scan_mtr got committed
+@param[in]	force		true to insert the rows even if fewer than
+				innodb_sort_buffer_size bytes are cached
 @return DB_SUCCESS or error number */
 static
 dberr_t
@@ -1560,7 +1709,8 @@ row_merge_spatial_rows(
 	mem_heap_t*		sp_heap,
 	btr_pcur_t*		pcur,
 	mtr_t*			mtr,
-	bool*			mtr_committed)
+	bool*			mtr_committed,
+	bool			force)
 {
 	dberr_t			err = DB_SUCCESS;
 
@@ -1570,6 +1720,12 @@ row_merge_spatial_rows(
 
 	ut_ad(sp_heap != NULL);
 
+	/* Cache the rows of several clustered index pages, so that they
+	can be inserted in a spatially clustered order. */
+	if (!force && mem_heap_get_size(sp_heap) < srv_sort_buf_size) {
+		return(DB_SUCCESS);
+	}
+
 	for (ulint j = 0; j < num_spatial; j++) {
 		err = sp_tuples[j]->insert(
 			trx_id, row_heap,
@@ -1899,7 +2055,7 @@ row_merge_read_clustered_index(
 			err = row_merge_spatial_rows(
 				trx->id, sp_tuples, num_spatial,
 				row_heap, sp_heap, &pcur,
-				&mtr, &mtr_committed);
+				&mtr, &mtr_committed, false);
 
 			if (err != DB_SUCCESS) {
 				goto func_exit;
@@ -1960,8 +2116,24 @@ scan_next:
 end_of_index:
 					row = NULL;
 					mtr_commit(&mtr);
+
+					/* Insert the spatial index rows
+					that are still cached. */
+					bool	committed = true;
+
+					err = row_merge_spatial_rows(
+						trx->id, sp_tuples,
+						num_spatial, row_heap,
+						sp_heap, &pcur, &mtr,
+						&committed, true);
+
 					mem_heap_free(row_heap);
 					ut_free(nonnull);
+
+					if (err != DB_SUCCESS) {
+						goto all_done;
+					}
+
 					goto write_buffers;
 				}
 			} else {
@@ -2288,18 +2460,19 @@ write_buffers:
 					if (row != NULL) {
 						bool	mtr_committed = false;
 
-						/* We have to do insert the
-						cached spatial index rows, since
-						after the mtr_commit, the cluster
-						index page could be updated, then
-						the data in cached rows become
-						invalid. */
+						/* The cached spatial index
+						rows own copies of their
+						fields and stay valid after
+						the mtr_commit() below. Insert
+						them if enough rows have been
+						cached, else keep them for the
+						next batch. */
 						err = row_merge_spatial_rows(
 							trx->id, sp_tuples,
 							num_spatial,
 							row_heap, sp_heap,
 							&pcur, &mtr,
-							&mtr_committed);
+							&mtr_committed, false);
 
 						if (err != DB_SUCCESS) {
 							goto func_exit;
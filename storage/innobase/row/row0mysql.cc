@@ -191,6 +191,39 @@ row_mysql_prebuilt_free_blob_heap(
 	DBUG_VOID_RETURN;
 }
 
+/** Free the fetch cache in prebuilt. Any rows still cached are
+discarded, so when a scan is in progress the caller must only do this
+between batches, when n_fetch_cached is 0.
+@param[in,out]	prebuilt	prebuilt struct of a ha_innobase:: table
+handle */
+void
+row_mysql_prebuilt_free_fetch_cache(
+	row_prebuilt_t*	prebuilt)
+{
+	byte*	base = prebuilt->fetch_cache[0] - 4;
+	byte*	ptr = base;
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_size; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		byte*	row = ptr;
+		ut_a(row == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+	}
+
+	ut_free(base);
+	ut_free(prebuilt->fetch_cache);
+
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_size = 0;
+}
+
 /*******************************************************************//**
 Stores a >= 5.0.3 format true VARCHAR length to dest, in the MySQL row
 format.
@@ -1051,25 +1084,8 @@ row_prebuilt_free(
 		mem_heap_free(prebuilt->old_vers_heap);
 	}
 
-	if (prebuilt->fetch_cache[0] != NULL) {
-		byte*	base = prebuilt->fetch_cache[0] - 4;
-		byte*	ptr = base;
-
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
-			ulint	magic1 = mach_read_from_4(ptr);
-			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-
-			byte*	row = ptr;
-			ut_a(row == prebuilt->fetch_cache[i]);
-			ptr += prebuilt->mysql_row_len;
-
-			ulint	magic2 = mach_read_from_4(ptr);
-			ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-		}
-
-		ut_free(base);
+	if (prebuilt->fetch_cache != NULL) {
+		row_mysql_prebuilt_free_fetch_cache(prebuilt);
 	}
 
 	if (prebuilt->rtr_info) {
@@ -1722,6 +1738,7 @@ row_insert_for_mysql_using_ins_graph(
 
 	row_get_prebuilt_insert_row(prebuilt);
 	node = prebuilt->ins_node;
+	node->clust_hint = prebuilt->ins_batch ? &prebuilt->ins_hint : NULL;
         // 把mysql中的一行转成innodb中的一行
 	row_mysql_convert_row_to_innobase(node->row, prebuilt, mysql_rec,
 					  &blob_heap);
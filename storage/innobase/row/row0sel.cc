@@ -65,6 +65,7 @@ Created 12/19/1997 Heikki Tuuri
 #include "row0mysql.h"
 #include "read0read.h"
 #include "buf0lru.h"
+#include "buf0rea.h"
 #include "ha_prototypes.h"
 #include "srv0mon.h"
 #include "ut0new.h"
@@ -2730,6 +2731,174 @@ row_sel_convert_mysql_key_to_innobase(
     dtuple_set_n_fields(tuple, n_fields);
 }
 
+/** Reads ahead the clustered index leaf pages of rows that are about to be
+fetched by their row references in the given order. DS-MRR buffers the row
+references of a secondary index range scan and sorts them before it calls
+handler::rnd_pos() for each one. Without read-ahead, every leaf page that
+is not in the buffer pool would be read synchronously by the first lookup
+that needs it. The child page numbers are taken from the level 1 node
+pointers, and consecutive references that fall on the same level 1 page
+are resolved without searching the tree from the root again.
+@param[in]	prebuilt	prebuilt struct in the handle
+@param[in]	refs		first row reference, in the format of
+				handler::ref
+@param[in]	n_refs		number of row references
+@param[in]	ref_len		length of a row reference
+@param[in]	ref_step	distance in bytes between two consecutive
+				row references */
+void
+row_sel_prefetch_clust_leaves_for_mysql(
+    row_prebuilt_t *prebuilt,
+    const byte *refs,
+    ulint n_refs,
+    ulint ref_len,
+    ulint ref_step)
+{
+    dict_table_t *table = prebuilt->table;
+    dict_index_t *clust_index = dict_table_get_first_index(table);
+
+    if (n_refs < 2
+        || dict_table_is_intrinsic(table)
+        || dict_table_is_discarded(table)
+        || table->ibd_file_missing
+        || dict_index_is_corrupted(clust_index)) {
+        return;
+    }
+
+    const ulint n_unique = dict_index_get_n_unique(clust_index);
+    const ulint space = dict_index_get_space(clust_index);
+    const page_size_t page_size(dict_table_page_size(table));
+
+    mem_heap_t *heap = mem_heap_create(
+        prebuilt->srch_key_val_len + DTUPLE_EST_ALLOC(n_unique));
+    dtuple_t *tuple = dtuple_create(heap, n_unique);
+    byte *key_buf = static_cast<byte *>(
+        mem_heap_alloc(heap, prebuilt->srch_key_val_len));
+
+    dict_index_copy_types(tuple, clust_index, n_unique);
+
+    mem_heap_t *offsets_heap = NULL;
+    ulint offsets_[REC_OFFS_NORMAL_SIZE];
+    ulint *offsets = offsets_;
+    rec_offs_init(offsets_);
+
+    /* Do not queue more reads for one batch than the server is
+    configured to do in a second. */
+    const ulint max_reads = srv_io_capacity;
+
+    ulint n_reads = 0;
+    ulint n_queued = 0;
+    ulint last_leaf = FIL_NULL;
+    buf_block_t *block = NULL;
+    page_cur_t page_cur;
+    mtr_t mtr;
+
+    for (ulint i = 0; i < n_refs && n_reads < max_reads;
+         i++, refs += ref_step) {
+
+        row_sel_convert_mysql_key_to_innobase(
+            tuple, key_buf, prebuilt->srch_key_val_len, clust_index,
+            refs, ref_len, prebuilt->trx);
+
+        if (block != NULL) {
+            /* The references are sorted, so the node pointer
+            stays on the current level 1 page unless it is the
+            last record there and the page has a right sibling. */
+            page_cur_search(block, clust_index, tuple, &page_cur);
+
+            if (page_cur_is_before_first(&page_cur)
+                || (page_rec_is_last(page_cur_get_rec(&page_cur),
+                                     buf_block_get_frame(block))
+                    && btr_page_get_next(buf_block_get_frame(block),
+                                         &mtr) != FIL_NULL)) {
+                mtr_commit(&mtr);
+                block = NULL;
+            }
+        }
+
+        if (block == NULL) {
+            mtr_start(&mtr);
+            mtr_s_lock(dict_index_get_lock(clust_index), &mtr);
+
+            block = btr_root_block_get(clust_index, RW_S_LATCH, &mtr);
+
+            ulint level = btr_page_get_level(
+                buf_block_get_frame(block), &mtr);
+
+            if (level == 0) {
+                /* The root is the only leaf page. */
+                mtr_commit(&mtr);
+                block = NULL;
+                break;
+            }
+
+            for (;;) {
+                page_cur_search(block, clust_index, tuple, &page_cur);
+
+                /* The minimum record flag of the leftmost node
+                pointer makes it compare less than any key. */
+                ut_ad(!page_cur_is_before_first(&page_cur));
+
+                if (level == 1) {
+                    break;
+                }
+
+                offsets = rec_get_offsets(
+                    page_cur_get_rec(&page_cur), clust_index, offsets,
+                    ULINT_UNDEFINED, &offsets_heap);
+
+                block = btr_block_get(
+                    page_id_t(space, btr_node_ptr_get_child_page_no(
+                                  page_cur_get_rec(&page_cur), offsets)),
+                    page_size, RW_S_LATCH, clust_index, &mtr);
+
+                level--;
+            }
+        }
+
+        offsets = rec_get_offsets(
+            page_cur_get_rec(&page_cur), clust_index, offsets,
+            ULINT_UNDEFINED, &offsets_heap);
+
+        const ulint leaf = btr_node_ptr_get_child_page_no(
+            page_cur_get_rec(&page_cur), offsets);
+
+        if (leaf == last_leaf) {
+            continue;
+        }
+
+        last_leaf = leaf;
+
+        const page_id_t page_id(space, leaf);
+
+        if (buf_read_page_background(page_id, page_size, false)) {
+            /* Account the pages like the linear read-ahead does,
+            so that unused ones show up in n_ra_pages_evicted. */
+            buf_pool_get(page_id)->stat.n_ra_pages_read++;
+            n_reads++;
+
+            if (++n_queued >= 64) {
+                os_aio_simulated_wake_handler_threads();
+                n_queued = 0;
+            }
+        }
+    }
+
+    if (block != NULL) {
+        mtr_commit(&mtr);
+    }
+
+    if (n_queued > 0) {
+        os_aio_simulated_wake_handler_threads();
+    }
+
+    if (offsets_heap != NULL) {
+        mem_heap_free(offsets_heap);
+    }
+
+    mem_heap_free(heap);
+}
+
 /**************************************************************/ /**
 Stores the row id to the prebuilt struct. */
 static
@@ -3387,6 +3556,52 @@ row_sel_build_prev_vers_for_mysql(
     return (err);
 }
 
+/** Position prebuilt->clust_pcur on prebuilt->clust_ref. Secondary index
+records that are next to each other often point to clustered index
+records on the same leaf page, for example when the secondary key is
+correlated with the primary key. The leaf page of the previous lookup is
+therefore tried first, and the tree is searched from the root only if
+the record cannot be on that page.
+@param[in,out]	prebuilt	prebuilt struct in the handle
+@param[in]	clust_index	clustered index
+@param[in,out]	mtr		mini-transaction */
+static
+void
+row_sel_open_clust_pcur_for_mysql(
+    row_prebuilt_t *prebuilt,
+    dict_index_t *clust_index,
+    mtr_t *mtr)
+{
+    btr_pcur_t *pcur = prebuilt->clust_pcur;
+
+    if (dict_table_is_intrinsic(clust_index->table)) {
+        btr_pcur_open_with_no_init(clust_index, prebuilt->clust_ref,
+                                   PAGE_CUR_LE, BTR_SEARCH_LEAF,
+                                   pcur, 0, mtr);
+        return;
+    }
+
+    if (btr_cur_search_leaf_with_hint(
+            &prebuilt->clust_hint, clust_index, prebuilt->clust_ref,
+            BTR_SEARCH_LEAF, btr_pcur_get_btr_cur(pcur),
+            __FILE__, __LINE__, mtr)) {
+        /* Same state as btr_pcur_open_with_no_init() leaves. */
+        pcur->latch_mode = BTR_SEARCH_LEAF;
+        pcur->search_mode = PAGE_CUR_LE;
+        pcur->pos_state = BTR_PCUR_IS_POSITIONED;
+        pcur->old_stored = false;
+        pcur->trx_if_known = NULL;
+        return;
+    }
+
+    btr_pcur_open_with_no_init(clust_index, prebuilt->clust_ref,
+                               PAGE_CUR_LE, BTR_SEARCH_LEAF,
+                               pcur, 0, mtr);
+
+    btr_cur_leaf_hint_store(&prebuilt->clust_hint,
+                            btr_pcur_get_btr_cur(pcur));
+}
+
 /*********************************************************************/ /**
 Retrieves the clustered index record corresponding to a record in a
 non-clustered index. Does the necessary locking. Used in the MySQL
@@ -3432,9 +3647,7 @@ row_sel_get_clust_rec_for_mysql(
 
     clust_index = dict_table_get_first_index(sec_index->table);
 
-    btr_pcur_open_with_no_init(clust_index, prebuilt->clust_ref,
-                               PAGE_CUR_LE, BTR_SEARCH_LEAF,
-                               prebuilt->clust_pcur, 0, mtr);
+    row_sel_open_clust_pcur_for_mysql(prebuilt, clust_index, mtr);
 
     clust_rec = btr_pcur_get_rec(prebuilt->clust_pcur);
 
@@ -3874,23 +4087,54 @@ row_sel_dequeue_cached_row_for_mysql(
     }
 }
 
+/** Get the number of rows to cache in the next batch of a scan. The first
+batch after positioning the cursor caches MYSQL_FETCH_CACHE_SIZE rows,
+because a query with a small LIMIT may not read any further. After that,
+a batch caches as many rows as have been fetched so far, which doubles
+the batch size while the scan goes on, up to what fits in
+MYSQL_FETCH_CACHE_MAX_BYTES.
+@param[in]	prebuilt	prebuilt struct
+@return number of rows to cache */
+static
+ulint
+row_sel_fetch_cache_limit(
+    const row_prebuilt_t *prebuilt)
+{
+    ulint max_rows = MYSQL_FETCH_CACHE_MAX_BYTES
+                     / (prebuilt->mysql_row_len + 8);
+
+    max_rows = ut_min(max_rows, ulint(MYSQL_FETCH_CACHE_MAX_SIZE));
+    max_rows = ut_max(max_rows, ulint(MYSQL_FETCH_CACHE_SIZE));
+
+    if (prebuilt->n_rows_fetched <= MYSQL_FETCH_CACHE_SIZE) {
+        return (MYSQL_FETCH_CACHE_SIZE);
+    }
+
+    return (ut_min(prebuilt->n_rows_fetched, max_rows));
+}
+
 /********************************************************************/ /**
 Initialise the prefetch cache. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
     /*========================*/
-    row_prebuilt_t *prebuilt) /*!< in/out: prebuilt struct */
+    row_prebuilt_t *prebuilt, /*!< in/out: prebuilt struct */
+    ulint n_rows) /*!< in: number of rows to make room for */
 {
     ulint i;
     ulint sz;
     byte *ptr;
 
     /* Reserve space for the magic number. */
-    sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+    sz = n_rows * (prebuilt->mysql_row_len + 8);
     ptr = static_cast<byte *>(ut_malloc_nokey(sz));
 
-    for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+    prebuilt->fetch_cache = static_cast<byte **>(
+        ut_malloc_nokey(n_rows * sizeof(*prebuilt->fetch_cache)));
+    prebuilt->fetch_cache_size = n_rows;
+
+    for (i = 0; i < n_rows; i++) {
         /* A user has reported memory corruption in these
         buffers in Linux. Put magic numbers there to help
         to track a possible bug. */
@@ -3916,13 +4160,19 @@ row_sel_fetch_last_buf(
     row_prebuilt_t *prebuilt) /*!< in/out: prebuilt struct */
 {
     ut_ad(!prebuilt->templ_contains_blob);
-    ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+    ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
-    if (prebuilt->fetch_cache[0] == NULL) {
-        /* Allocate memory for the fetch cache */
+    if (prebuilt->fetch_cache_size < prebuilt->fetch_cache_limit) {
+        /* Allocate memory for the fetch cache, or grow it.
+        The cache is empty at the start of a batch. */
         ut_ad(prebuilt->n_fetch_cached == 0);
 
-        row_sel_prefetch_cache_init(prebuilt);
+        if (prebuilt->fetch_cache != NULL) {
+            row_mysql_prebuilt_free_fetch_cache(prebuilt);
+        }
+
+        row_sel_prefetch_cache_init(
+            prebuilt, prebuilt->fetch_cache_limit);
     }
 
     ut_ad(prebuilt->fetch_cache_first == 0);
@@ -4729,7 +4979,8 @@ row_search_mvcc(
         }
 
         if (prebuilt->fetch_cache_first > 0
-            && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+            && prebuilt->fetch_cache_first
+            < prebuilt->fetch_cache_limit) {
             /* The previous returned row was popped from the fetch
             cache, but the cache was not full at the time of the
             popping: no more rows can exist in the result set */
@@ -4748,6 +4999,8 @@ row_search_mvcc(
         mode = pcur->search_mode;
     }
 
+    prebuilt->fetch_cache_limit = row_sel_fetch_cache_limit(prebuilt);
+
     /* In a search where at most one record in the index may match, we
     can use a LOCK_REC_NOT_GAP type record lock when locking a
     non-delete-marked matching record.
@@ -5866,7 +6119,7 @@ locks_ok:
         not cache rows because there the cursor is a scrollable
         cursor. */
 
-        ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+        ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
         /* We only convert from InnoDB row format to MySQL row
         format when ICP is disabled. */
@@ -5918,7 +6171,7 @@ locks_ok:
             row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
         }
 
-        if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+        if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
             goto next_rec;
         }
     } else {
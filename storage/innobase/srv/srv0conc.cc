@@ -57,7 +57,10 @@ Created 2011/04/18 Sunny Bains
 SQL query after it has once got the ticket. */
 ulong	srv_n_free_tickets_to_enter = 500;
 
-/** Maximum sleep delay (in micro-seconds), value of 0 disables it. */
+/** Upper limit of srv_thread_sleep_delay (in micro-seconds), value of 0
+disables it. Waiting threads are woken up as soon as a place becomes
+free, so the delay is no longer adjusted adaptively; it only bounds how
+late a waiting thread notices a change of srv_thread_concurrency. */
 ulong	srv_adaptive_max_sleep_delay = 150000;
 
 ulong	srv_thread_sleep_delay	= 10000;
@@ -75,6 +78,25 @@ we could get a deadlock. Value of 0 will disable the concurrency check. */
 
 ulong	srv_thread_concurrency	= 0;
 
+/** A thread waiting in the FIFO for permission to enter InnoDB. The slot
+lives on the stack of the waiting thread. */
+struct srv_conc_slot_t {
+	/** Event the thread waits on */
+	os_event_t	event;
+
+	/** The queue the slot is linked to, or NULL */
+	UT_LIST_BASE_NODE_T(srv_conc_slot_t)*	list;
+
+	/** true if the thread that removed the slot from the queue
+	reserved a place in srv_conc.n_active for the waiting thread */
+	bool		granted;
+
+	/** Link in srv_conc.lock_holders or srv_conc.waiters */
+	UT_LIST_NODE_T(srv_conc_slot_t)	queue;
+};
+
+typedef UT_LIST_BASE_NODE_T(srv_conc_slot_t) srv_conc_queue_t;
+
 /** Variables tracking the active and waiting threads. */
 struct srv_conc_t {
 	char		pad[64  - (sizeof(ulint) + sizeof(lint))];
@@ -89,6 +111,17 @@ struct srv_conc_t {
 	/** Number of OS threads waiting in the FIFO for permission to
 	enter InnoDB */
 	volatile lint	n_waiting;
+
+	/** Mutex protecting the queues and the slots linked to them */
+	OSMutex		mutex;
+
+	/** Waiting threads whose transactions hold locks. They are
+	admitted before the threads in the waiters queue, because
+	other transactions may be waiting for those locks. */
+	srv_conc_queue_t lock_holders;
+
+	/** Other waiting threads, in arrival order */
+	srv_conc_queue_t waiters;
 };
 
 /* Control variables for tracking concurrency. */
@@ -107,127 +140,209 @@ srv_enter_innodb_with_tickets(
 	trx->n_tickets_to_enter_innodb = srv_n_free_tickets_to_enter;
 }
 
-/*********************************************************************//**
-Handle the scheduling of a user thread that wants to enter InnoDB.  Setting
-srv_adaptive_max_sleep_delay > 0 switches the adaptive sleep calibration to
-ON. When set, we want to wait in the queue for as little time as possible.
-However, very short waits will result in a lot of context switches and that
-is also not desirable. When threads need to sleep multiple times we increment
-os_thread_sleep_delay by one. When we see threads getting a slot without
-waiting and there are no other threads waiting in the queue, we try and reduce
-the wait as much as we can. Currently we reduce it by half each time. If the
-thread only had to wait for one turn before it was able to enter InnoDB we
-decrement it by one. This is to try and keep the sleep time stable around the
-"optimum" sleep time. */
+/** Try to reserve a place for a thread inside InnoDB.
+@return true if srv_conc.n_active was incremented */
+static
+bool
+srv_conc_reserve()
+{
+	if (srv_conc.n_active >= (lint) srv_thread_concurrency) {
+		return(false);
+	}
+
+	if (os_atomic_increment_lint(&srv_conc.n_active, 1)
+	    <= (lint) srv_thread_concurrency) {
+
+		return(true);
+	}
+
+	/* Since there were no free seats, we relinquish the
+	overbooked ticket. */
+	(void) os_atomic_decrement_lint(&srv_conc.n_active, 1);
+
+	return(false);
+}
+
+/** Get the first waiting thread, if any.
+@return the first slot in the queues, or NULL */
+static
+srv_conc_slot_t*
+srv_conc_get_first_slot()
+{
+	srv_conc_slot_t*	slot = UT_LIST_GET_FIRST(srv_conc.lock_holders);
+
+	if (slot == NULL) {
+		slot = UT_LIST_GET_FIRST(srv_conc.waiters);
+	}
+
+	return(slot);
+}
+
+/** Remove a waiting thread from its queue. The caller must hold
+srv_conc.mutex.
+@param[in,out]	slot	slot of the waiting thread */
 static
 void
-srv_conc_enter_innodb_with_atomics(
-/*===============================*/
-	trx_t*	trx)			/*!< in/out: transaction that wants
-					to enter InnoDB */
+srv_conc_dequeue(
+	srv_conc_slot_t*	slot)
 {
-	ulint	n_sleeps = 0;
-	ibool	notified_mysql = FALSE;
+	ut_ad(slot->list != NULL);
 
-	ut_a(!trx->declared_to_be_inside_innodb);
+	UT_LIST_REMOVE(*slot->list, slot);
 
-	for (;;) {
-		ulint	sleep_in_us;
+	slot->list = NULL;
 
-		if (srv_thread_concurrency == 0) {
+	(void) os_atomic_decrement_lint(&srv_conc.n_waiting, 1);
+}
+
+/** Hand over free places inside InnoDB to the waiting threads, in queue
+order. If the concurrency check has been disabled, all waiting threads
+are released. */
+static
+void
+srv_conc_wake_waiters()
+{
+	srv_conc.mutex.enter();
 
-			if (notified_mysql) {
+	for (;;) {
+		srv_conc_slot_t*	slot = srv_conc_get_first_slot();
+
+		if (slot == NULL) {
+			break;
+		}
 
-				(void) os_atomic_decrement_lint(
-					&srv_conc.n_waiting, 1);
+		if (srv_thread_concurrency > 0) {
 
-				thd_wait_end(trx->mysql_thd);
+			if (!srv_conc_reserve()) {
+				break;
 			}
 
-			return;
+			slot->granted = true;
 		}
 
-		if (srv_conc.n_active < (lint) srv_thread_concurrency) {
-			ulint	n_active;
+		srv_conc_dequeue(slot);
 
-			/* Check if there are any free tickets. */
-			n_active = os_atomic_increment_lint(
-				&srv_conc.n_active, 1);
+		os_event_set(slot->event);
+	}
 
-			if (n_active <= srv_thread_concurrency) {
+	srv_conc.mutex.exit();
+}
+/*********************************************************************//**
+Handle the scheduling of a user thread that wants to enter InnoDB. If no
+other thread is waiting and there is a free place, the thread enters
+straight away. Otherwise it joins the back of the FIFO and waits on its
+own event until a thread leaving InnoDB hands its place over. Threads
+whose transactions hold locks are queued ahead of the others, so that
+they can finish and release the locks that others may be waiting for.
+The waiting thread wakes up every srv_thread_sleep_delay microseconds
+(capped by srv_adaptive_max_sleep_delay) to notice changes of
+srv_thread_concurrency. */
+static
+void
+srv_conc_enter_innodb_with_atomics(
+/*===============================*/
+	trx_t*	trx)			/*!< in/out: transaction that wants
+					to enter InnoDB */
+{
+	ut_a(!trx->declared_to_be_inside_innodb);
 
-				srv_enter_innodb_with_tickets(trx);
+	if (srv_thread_concurrency == 0) {
+		return;
+	}
 
-				if (notified_mysql) {
+	/* Don't overtake the threads that are already waiting. */
+	if (srv_conc.n_waiting == 0 && srv_conc_reserve()) {
 
-					(void) os_atomic_decrement_lint(
-						&srv_conc.n_waiting, 1);
+		srv_enter_innodb_with_tickets(trx);
 
-					thd_wait_end(trx->mysql_thd);
-				}
+		return;
+	}
 
-				if (srv_adaptive_max_sleep_delay > 0) {
-					if (srv_thread_sleep_delay > 20
-					    && n_sleeps == 1) {
+	/* Release possible search system latch this thread has */
+	if (trx->has_search_latch) {
+		trx_search_latch_release_if_reserved(trx);
+	}
 
-						--srv_thread_sleep_delay;
-					}
+	thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
 
-					if (srv_conc.n_waiting == 0) {
-						srv_thread_sleep_delay >>= 1;
-					}
-				}
+	srv_conc_slot_t	slot;
+	uintmax_t	start_time = ut_time_monotonic_us();
 
-				return;
-			}
+	if (trx->conc_wait_event == NULL) {
+		trx->conc_wait_event = os_event_create(0);
+	}
 
-			/* Since there were no free seats, we relinquish
-			the overbooked ticket. */
+	slot.event = trx->conc_wait_event;
+	slot.granted = false;
 
-			(void) os_atomic_decrement_lint(
-				&srv_conc.n_active, 1);
-		}
+	/* Reading the lock list of our own transaction without
+	lock_sys->mutex is only a hint, but that is all we need here. */
+	slot.list = UT_LIST_GET_LEN(trx->lock.trx_locks) > 0
+		? &srv_conc.lock_holders
+		: &srv_conc.waiters;
 
-		if (!notified_mysql) {
-			(void) os_atomic_increment_lint(
-				&srv_conc.n_waiting, 1);
+	srv_conc.mutex.enter();
 
-			/* Release possible search system latch this
-			thread has */
+	UT_LIST_ADD_LAST(*slot.list, &slot);
 
-			if (trx->has_search_latch) {
-				trx_search_latch_release_if_reserved(trx);
-			}
+	/* n_waiting must be incremented before srv_conc_reserve() reads
+	n_active, so that a thread leaving InnoDB either sees us waiting
+	or leaves a free place for us to take. */
+	(void) os_atomic_increment_lint(&srv_conc.n_waiting, 1);
 
-			thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
+	for (;;) {
+		if (slot.list == NULL) {
+			/* A leaving thread removed us from the queue. */
+			break;
+		}
 
-			notified_mysql = TRUE;
+		if (srv_thread_concurrency == 0) {
+			srv_conc_dequeue(&slot);
+			break;
+		}
+
+		if (&slot == srv_conc_get_first_slot() && srv_conc_reserve()) {
+			slot.granted = true;
+			srv_conc_dequeue(&slot);
+			break;
 		}
 
+		int64_t	sig_count = os_event_reset(slot.event);
+
+		srv_conc.mutex.exit();
+
 		DEBUG_SYNC_C("user_thread_waiting");
-		trx->op_info = "sleeping before entering InnoDB";
 
-		sleep_in_us = srv_thread_sleep_delay;
+		trx->op_info = "waiting in InnoDB queue";
 
-		/* Guard against overflow when adaptive sleep delay is on. */
+		ulint	wait_in_us = srv_thread_sleep_delay;
 
 		if (srv_adaptive_max_sleep_delay > 0
-		    && sleep_in_us > srv_adaptive_max_sleep_delay) {
+		    && wait_in_us > srv_adaptive_max_sleep_delay) {
 
-			sleep_in_us = srv_adaptive_max_sleep_delay;
-			srv_thread_sleep_delay = static_cast<ulong>(sleep_in_us);
+			wait_in_us = srv_adaptive_max_sleep_delay;
 		}
 
-		os_thread_sleep(sleep_in_us);
+		/* A zero timeout would make us spin on srv_conc.mutex. */
+		os_event_wait_time_low(
+			slot.event, ut_max(wait_in_us, ulint(1000)),
+			sig_count);
 
 		trx->op_info = "";
 
-		++n_sleeps;
+		srv_conc.mutex.enter();
+	}
 
-		if (srv_adaptive_max_sleep_delay > 0 && n_sleeps > 1) {
-			++srv_thread_sleep_delay;
-		}
+	srv_conc.mutex.exit();
+
+	if (slot.granted) {
+		srv_enter_innodb_with_tickets(trx);
 	}
+
+	srv_stats.n_conc_wait_count.inc();
+	srv_stats.n_conc_wait_time.add(ut_time_monotonic_us() - start_time);
+
+	thd_wait_end(trx->mysql_thd);
 }
 
 /*********************************************************************//**
@@ -242,6 +357,12 @@ srv_conc_exit_innodb_with_atomics(
 	trx->declared_to_be_inside_innodb = FALSE;
 
 	(void) os_atomic_decrement_lint(&srv_conc.n_active, 1);
+
+	/* n_active must be decremented before n_waiting is read, see
+	srv_conc_enter_innodb_with_atomics(). */
+	if (srv_conc.n_waiting > 0) {
+		srv_conc_wake_waiters();
+	}
 }
 
 /*********************************************************************//**
@@ -340,3 +461,22 @@ srv_conc_get_active_threads(void)
 	return(srv_conc.n_active);
  }
 
+/** Initialize the concurrency manager. */
+void
+srv_conc_init()
+{
+	srv_conc.mutex.init();
+
+	UT_LIST_INIT(srv_conc.lock_holders, &srv_conc_slot_t::queue);
+	UT_LIST_INIT(srv_conc.waiters, &srv_conc_slot_t::queue);
+}
+
+/** Free the concurrency manager. */
+void
+srv_conc_free()
+{
+	ut_ad(UT_LIST_GET_LEN(srv_conc.lock_holders) == 0);
+	ut_ad(UT_LIST_GET_LEN(srv_conc.waiters) == 0);
+
+	srv_conc.mutex.destroy();
+}
@@ -101,6 +101,9 @@ bool	srv_buf_resize_thread_active = false;
 
 ibool	srv_dict_stats_thread_active = FALSE;
 
+/** Number of background threads that recalculate persistent statistics */
+ulong	srv_n_stats_threads = 1;
+
 const char*	srv_main_thread_op_info = "";
 
 /** Prefix used by MySQL to indicate pre-5.1 table name encoding */
@@ -196,6 +199,17 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio = TRUE;
 
+/** Whether to look for the data file of every file-per-table tablespace
+at startup. If FALSE and no redo was applied, the data files are opened
+when the tablespaces are first accessed. */
+my_bool	srv_validate_tablespace_paths = TRUE;
+
+/** Minimum percentage of a page that transparent page compression must
+save for the page to be written compressed, 0 if any saving is enough.
+Tablespaces whose pages repeatedly fail this are periodically written
+without trying to compress them. */
+ulong	srv_page_compression_min_saving_pct = 0;
+
 #ifdef UNIV_DEBUG
 /** Force all user tables to use page compression. */
 ulong	srv_debug_compress;
@@ -277,6 +291,8 @@ ulint	srv_buf_pool_base_size	= 0;
 ulint	srv_buf_pool_curr_size	= 0;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** Seconds between two periodic BP dumps, 0 if disabled */
+ulong	srv_buf_dump_interval;
 /** Lock table size in bytes */
 ulint	srv_lock_table_size	= ULINT_MAX;
 
@@ -296,6 +312,10 @@ ulong	srv_read_ahead_threshold	= 56;
 of the buffer pool. */
 uint	srv_change_buffer_max_size = CHANGE_BUFFER_DEFAULT_SIZE;
 
+/** Percentage of innodb_io_capacity used by the master thread for
+merging the change buffer in the background while the server is active */
+ulong	srv_change_buffer_merge_pct = 5;
+
 /* This parameter is used to throttle the number of insert buffers that are
 merged in a batch. By increasing this parameter on a faster disk you can
 possibly reduce the number of I/O operations performed to complete the
@@ -484,6 +504,14 @@ current_time % 5 != 0. */
 # define	SRV_MASTER_PURGE_INTERVAL		(10)
 # define	SRV_MASTER_DICT_LRU_INTERVAL		(47)
 
+/** Number of tables checked for eviction from the table cache before
+the master thread releases the dictionary latches */
+# define	SRV_MASTER_DICT_LRU_BATCH		(1000)
+
+/** Maximum number of data files closed by the master thread in one
+invocation of fil_close_lru_files() */
+# define	SRV_MASTER_FILE_CLOSE_BATCH		(100)
+
 /** Acquire the system_mutex. */
 #define srv_sys_mutex_enter() do {			\
 	mutex_enter(&srv_sys->mutex);			\
@@ -665,6 +693,11 @@ PSI_stage_info	srv_stage_alter_table_read_pk_internal_sort
 /** Performance schema stage event for monitoring buffer pool load progress. */
 PSI_stage_info	srv_stage_buffer_pool_load
 	= {0, "buffer pool load", PSI_FLAG_STAGE_PROGRESS};
+
+/** Performance schema stage event for monitoring ALTER TABLE ... IMPORT
+TABLESPACE progress fil_tablespace_iterate(). */
+PSI_stage_info	srv_stage_import_tablespace
+	= {0, "import tablespace", PSI_FLAG_STAGE_PROGRESS};
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
 /*********************************************************************//**
@@ -977,6 +1010,8 @@ srv_init(void)
 
 	mutex_create(LATCH_ID_SRV_INNODB_MONITOR, &srv_innodb_monitor_mutex);
 
+	srv_conc_init();
+
 	if (!srv_read_only_mode) {
 
 		/* Number of purge threads + master thread */
@@ -1054,6 +1089,8 @@ srv_free(void)
 	mutex_free(&srv_innodb_monitor_mutex);
 	mutex_free(&page_zip_stat_per_index_mutex);
 
+	srv_conc_free();
+
 	{
 		mutex_free(&srv_sys->mutex);
 		mutex_free(&srv_sys->tasks_mutex);
@@ -1271,6 +1308,7 @@ srv_printf_innodb_monitor(
 	      "FILE I/O\n"
 	      "--------\n", file);
 	os_aio_print(file);
+	fil_print_compression_stats(file);
 
 	fputs("-------------------------------------\n"
 	      "INSERT BUFFER AND ADAPTIVE HASH INDEX\n"
@@ -1456,6 +1494,25 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_page_size = UNIV_PAGE_SIZE;
 
+	export_vars.innodb_page_compression_compressed =
+		srv_stats.page_compression_compressed;
+
+	export_vars.innodb_page_compression_failed =
+		srv_stats.page_compression_failed;
+
+	export_vars.innodb_page_compression_skipped =
+		srv_stats.page_compression_skipped;
+
+	export_vars.innodb_page_compression_saved =
+		srv_stats.page_compression_saved;
+
+	export_vars.innodb_page_compression_time =
+		srv_stats.page_compression_time / 1000;
+
+	export_vars.innodb_ibuf_merge_time = srv_stats.ibuf_merge_time / 1000;
+
+	export_vars.innodb_ibuf_merges = ibuf->n_merges;
+
 	export_vars.innodb_log_waits = srv_stats.log_waits;
 
 	export_vars.innodb_os_log_written = srv_stats.os_log_written;
@@ -1502,6 +1559,12 @@ srv_export_innodb_status(void)
 	export_vars.innodb_row_lock_time_max =
 		lock_sys->n_lock_max_wait_time / 1000;
 
+	export_vars.innodb_thread_concurrency_waits =
+		srv_stats.n_conc_wait_count;
+
+	export_vars.innodb_thread_concurrency_wait_time =
+		srv_stats.n_conc_wait_time / 1000;
+
 	export_vars.innodb_rows_read = srv_stats.n_rows_read;
 
 	export_vars.innodb_rows_inserted = srv_stats.n_rows_inserted;
@@ -1977,7 +2040,11 @@ srv_sync_log_buffer_in_background(void)
 }
 
 /********************************************************************//**
-Make room in the table cache by evicting an unused table.
+Make room in the table cache by evicting unused tables. The LRU list is
+checked in batches of SRV_MASTER_DICT_LRU_BATCH tables, and
+dict_operation_lock and dict_sys->mutex are released between two batches,
+so that opening tables, purge and DDL are not blocked while a big table
+cache is scanned.
 @return number of tables evicted. */
 static
 ulint
@@ -1986,17 +2053,40 @@ srv_master_evict_from_table_cache(
 	ulint	pct_check)	/*!< in: max percent to check */
 {
 	ulint	n_tables_evicted = 0;
+	ulint	n_to_check = ULINT_UNDEFINED;
+
+	ut_a(pct_check > 0);
+	ut_a(pct_check <= 100);
+
+	for (;;) {
+		rw_lock_x_lock(dict_operation_lock);
+
+		dict_mutex_enter_for_mysql();
+
+		if (n_to_check == ULINT_UNDEFINED) {
+			n_to_check = UT_LIST_GET_LEN(dict_sys->table_LRU)
+				* pct_check / 100;
+		}
 
-	rw_lock_x_lock(dict_operation_lock);
+		ulint	n_check = ut_min(n_to_check,
+					 ulint(SRV_MASTER_DICT_LRU_BATCH));
+		ulint	n_checked;
 
-	dict_mutex_enter_for_mysql();
+		n_tables_evicted += dict_make_room_in_cache(
+			innobase_get_table_cache_size(), n_check, &n_checked);
 
-	n_tables_evicted = dict_make_room_in_cache(
-		innobase_get_table_cache_size(), pct_check);
+		dict_mutex_exit_for_mysql();
 
-	dict_mutex_exit_for_mysql();
+		rw_lock_x_unlock(dict_operation_lock);
 
-	rw_lock_x_unlock(dict_operation_lock);
+		ut_ad(n_checked <= n_to_check);
+		n_to_check -= n_checked;
+
+		if (n_checked < n_check || n_to_check == 0
+		    || srv_shutdown_state > 0) {
+			break;
+		}
+	}
 
 	return(n_tables_evicted);
 }
@@ -2162,6 +2252,9 @@ srv_master_do_active_tasks(void)
 		srv_wake_purge_thread_if_not_active();
 	}
 
+	srv_main_thread_op_info = "closing data files";
+	fil_close_lru_files(SRV_MASTER_FILE_CLOSE_BATCH);
+
 	if (cur_time % SRV_MASTER_DICT_LRU_INTERVAL == 0) {
 		srv_main_thread_op_info = "enforcing dict cache limit";
 		ulint	n_evicted = srv_master_evict_from_table_cache(50);
@@ -2242,6 +2335,9 @@ srv_master_do_idle_tasks(void)
 		srv_wake_purge_thread_if_not_active();
 	}
 
+	srv_main_thread_op_info = "closing data files";
+	fil_close_lru_files(SRV_MASTER_FILE_CLOSE_BATCH);
+
 	srv_main_thread_op_info = "enforcing dict cache limit";
 	ulint	n_evicted = srv_master_evict_from_table_cache(100);
 	if (n_evicted != 0) {
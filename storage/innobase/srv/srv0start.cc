@@ -213,6 +213,7 @@ static PSI_stage_info*	srv_stages[] =
 	&srv_stage_alter_table_merge_sort,
 	&srv_stage_alter_table_read_pk_internal_sort,
 	&srv_stage_buffer_pool_load,
+	&srv_stage_import_tablespace,
 };
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
@@ -1647,7 +1648,7 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* srv_master_thread */
 			    + 1 /* srv_purge_coordinator_thread */
 			    + 1 /* buf_dump_thread */
-			    + 1 /* dict_stats_thread */
+			    + srv_n_stats_threads /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
@@ -2680,8 +2681,10 @@ files_checked:
 		/* Create the buffer pool dump/load thread */
 		os_thread_create(buf_dump_thread, NULL, NULL);
 
-		/* Create the dict stats gathering thread */
-		os_thread_create(dict_stats_thread, NULL, NULL);
+		/* Create the dict stats gathering threads */
+		for (ulint i = 0; i < srv_n_stats_threads; ++i) {
+			os_thread_create(dict_stats_thread, NULL, NULL);
+		}
 
 		/* Create the thread that will optimize the FTS sub-system. */
 		fts_optimize_init();
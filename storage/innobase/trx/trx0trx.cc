@@ -295,6 +295,10 @@ struct TrxFactory {
 		UT_DELETE(trx->xid);
 		ut_free(trx->detailed_error);
 
+		if (trx->conc_wait_event != NULL) {
+			os_event_destroy(trx->conc_wait_event);
+		}
+
 		mutex_free(&trx->mutex);
 		mutex_free(&trx->undo_mutex);
 
@@ -265,6 +265,172 @@ ut_crc32_64_legacy_big_endian_hw(
 	*len -= 8;
 }
 
+/* The crc32 instruction has a latency of 3 cycles and a throughput of 1
+per cycle, so a single dependency chain uses only a third of what the CPU
+can do. ut_crc32_hw() computes the CRC of three adjacent streams at once
+and combines the three results by "shifting" the first CRCs over the
+length of the following streams, that is by appending that many zero
+bytes to them. Appending a fixed number of zeros is a linear operation on
+the CRC, it is done with four table lookups, see ut_crc32_shift(). This is
+the approach of Mark Adler's crc32c.c. */
+
+/** Length of each of the three streams in the long loop of ut_crc32_hw() */
+static const ulint	UT_CRC32_LONG = 4096;
+
+/** Length of each of the three streams in the short loop of ut_crc32_hw() */
+static const ulint	UT_CRC32_SHORT = 256;
+
+/** CRC32-C polynomial, reversed */
+static const uint32_t	UT_CRC32_POLY = 0x82F63B78U;
+
+/** Tables that append UT_CRC32_LONG zero bytes to a CRC */
+static uint32_t	ut_crc32_long_shift[4][256];
+
+/** Tables that append UT_CRC32_SHORT zero bytes to a CRC */
+static uint32_t	ut_crc32_short_shift[4][256];
+
+/** Multiply a 32x32 matrix by a vector over GF(2).
+@param[in]	mat	matrix, one column per element
+@param[in]	vec	vector
+@return mat * vec */
+static
+uint32_t
+ut_crc32_gf2_matrix_times(
+	const uint32_t*	mat,
+	uint32_t	vec)
+{
+	uint32_t	sum = 0;
+
+	for (; vec != 0; vec >>= 1, mat++) {
+		if (vec & 1) {
+			sum ^= *mat;
+		}
+	}
+
+	return(sum);
+}
+
+/** Square a 32x32 matrix over GF(2).
+@param[out]	square	mat * mat
+@param[in]	mat	matrix */
+static
+void
+ut_crc32_gf2_matrix_square(
+	uint32_t*	square,
+	const uint32_t*	mat)
+{
+	for (ulint n = 0; n < 32; n++) {
+		square[n] = ut_crc32_gf2_matrix_times(mat, mat[n]);
+	}
+}
+
+/** Build the tables that append len zero bytes to a CRC.
+@param[out]	shift	tables, one per byte of the CRC
+@param[in]	len	number of zero bytes, must be a power of two */
+static
+void
+ut_crc32_shift_init(
+	uint32_t	shift[4][256],
+	ulint		len)
+{
+	uint32_t	even[32];
+	uint32_t	odd[32];
+	uint32_t	row = 1;
+
+	ut_ad(ut_is_2pow(len));
+
+	/* The operator for one zero bit */
+	odd[0] = UT_CRC32_POLY;
+	for (ulint n = 1; n < 32; n++) {
+		odd[n] = row;
+		row <<= 1;
+	}
+
+	/* Square it up to one zero byte and then to len zero bytes. */
+	ut_crc32_gf2_matrix_square(even, odd);
+	ut_crc32_gf2_matrix_square(odd, even);
+
+	const uint32_t*	op;
+
+	for (;;) {
+		ut_crc32_gf2_matrix_square(even, odd);
+		len >>= 1;
+		if (len == 0) {
+			op = even;
+			break;
+		}
+
+		ut_crc32_gf2_matrix_square(odd, even);
+		len >>= 1;
+		if (len == 0) {
+			op = odd;
+			break;
+		}
+	}
+
+	for (uint32_t n = 0; n < 256; n++) {
+		shift[0][n] = ut_crc32_gf2_matrix_times(op, n);
+		shift[1][n] = ut_crc32_gf2_matrix_times(op, n << 8);
+		shift[2][n] = ut_crc32_gf2_matrix_times(op, n << 16);
+		shift[3][n] = ut_crc32_gf2_matrix_times(op, n << 24);
+	}
+}
+
+/** Append a fixed number of zero bytes to a CRC.
+@param[in]	shift	tables built by ut_crc32_shift_init()
+@param[in]	crc	CRC, without the final inversion
+@return crc of the same data followed by the zero bytes */
+inline
+uint32_t
+ut_crc32_shift(
+	const uint32_t	shift[4][256],
+	uint32_t	crc)
+{
+	return(shift[0][crc & 0xFF]
+	       ^ shift[1][(crc >> 8) & 0xFF]
+	       ^ shift[2][(crc >> 16) & 0xFF]
+	       ^ shift[3][crc >> 24]);
+}
+
+/** Calculate CRC32 over 3 * n bytes as three interleaved streams of n bytes
+each, using a hardware/CPU instruction.
+@param[in,out]	crc	crc32 checksum so far when this function is called,
+when the function ends it will contain the new checksum
+@param[in,out]	data	data to be checksummed, must be 8-byte aligned, the
+pointer will be advanced with 3 * n bytes
+@param[in,out]	len	remaining bytes, it will be decremented with 3 * n
+@param[in]	n	length of each stream, a multiple of 8
+@param[in]	shift	tables that append n zero bytes to a CRC */
+inline
+void
+ut_crc32_3way_hw(
+	uint32_t*	crc,
+	const byte**	data,
+	ulint*		len,
+	ulint		n,
+	const uint32_t	shift[4][256])
+{
+	const uint64_t*	p0 = reinterpret_cast<const uint64_t*>(*data);
+	const uint64_t*	p1 = reinterpret_cast<const uint64_t*>(*data + n);
+	const uint64_t*	p2 = reinterpret_cast<const uint64_t*>(*data + 2 * n);
+	const uint64_t*	end = p1;
+	uint32_t	crc0 = *crc;
+	uint32_t	crc1 = 0;
+	uint32_t	crc2 = 0;
+
+	do {
+		crc0 = ut_crc32_64_low_hw(crc0, *p0++);
+		crc1 = ut_crc32_64_low_hw(crc1, *p1++);
+		crc2 = ut_crc32_64_low_hw(crc2, *p2++);
+	} while (p0 != end);
+
+	crc0 = ut_crc32_shift(shift, crc0) ^ crc1;
+	*crc = ut_crc32_shift(shift, crc0) ^ crc2;
+
+	*data += 3 * n;
+	*len -= 3 * n;
+}
+
 /** Calculates CRC32 using hardware/CPU instructions.
 @param[in]	buf	data over which to calculate CRC32
 @param[in]	len	data length
@@ -284,63 +450,17 @@ ut_crc32_hw(
 		ut_crc32_8_hw(&crc, &buf, &len);
 	}
 
-	/* Perf testing
-	./unittest/gunit/innodb/merge_innodb_tests-t --gtest_filter=ut0crc32.perf
-	on CPU "Intel(R) Core(TM) i7-4770 CPU @ 3.40GHz"
-	with different N in "while (len >= N) {" shows:
-	N=16
-	2.867254 sec
-	2.866860 sec
-	2.867973 sec
-
-	N=32
-	2.715725 sec
-	2.713008 sec
-	2.712520 sec
-	(5.36% speedup over N=16)
-
-	N=64
-	2.634140 sec
-	2.636558 sec
-	2.636488 sec
-	(2.88% speedup over N=32)
-
-	N=128
-	2.599534 sec
-	2.599919 sec
-	2.598035 sec
-	(1.39% speedup over N=64)
-
-	N=256
-	2.576993 sec
-	2.576748 sec
-	2.575700 sec
-	(0.87% speedup over N=128)
-
-	N=512
-	2.693928 sec
-	2.691663 sec
-	2.692142 sec
-	(4.51% slowdown over N=256)
-	*/
-	while (len >= 128) {
-		/* This call is repeated 16 times. 16 * 8 = 128. */
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
-		ut_crc32_64_hw(&crc, &buf, &len);
+	/* Run three independent crc32 dependency chains, first on long and
+	then on short streams, see ut_crc32_3way_hw(). A 16KiB page is
+	done with one long and five short rounds. */
+	while (len >= 3 * UT_CRC32_LONG) {
+		ut_crc32_3way_hw(&crc, &buf, &len, UT_CRC32_LONG,
+				 ut_crc32_long_shift);
+	}
+
+	while (len >= 3 * UT_CRC32_SHORT) {
+		ut_crc32_3way_hw(&crc, &buf, &len, UT_CRC32_SHORT,
+				 ut_crc32_short_shift);
 	}
 
 	while (len >= 8) {
@@ -728,6 +848,8 @@ ut_crc32_init()
 #endif /* UNIV_DEBUG_VALGRIND */
 
 	if (ut_crc32_sse2_enabled) {
+		ut_crc32_shift_init(ut_crc32_long_shift, UT_CRC32_LONG);
+		ut_crc32_shift_init(ut_crc32_short_shift, UT_CRC32_SHORT);
 		ut_crc32 = ut_crc32_hw;
 		ut_crc32_legacy_big_endian = ut_crc32_legacy_big_endian_hw;
 		ut_crc32_byte_by_byte = ut_crc32_byte_by_byte_hw;